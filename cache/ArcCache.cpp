@@ -0,0 +1,134 @@
+#include "ArcCache.h"
+#include "CachePolicy.h"
+#include "CacheTraces.h"
+#include <iostream>
+#include <cassert>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+bool contains(ArcCache<int, int>& cache, const int key) {
+    try {
+        cache.get(key);
+        return true;
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+}
+
+void testFrequentKeysSurviveScan() {
+    ArcCache<int, int> cache(4);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.get(1);
+    cache.get(2);
+
+    // A scan only churns T1; the twice-seen keys in T2 stay resident.
+    for (int k = 100; k < 120; ++k) {
+        cache.put(k, k);
+    }
+    assert(contains(cache, 1));
+    assert(contains(cache, 2));
+    assert(cache.size() == 4);
+}
+
+void testGhostHitGrowsRecencyTarget() {
+    ArcCache<int, int> cache(2);
+    cache.put(1, 1);
+    cache.get(1);    // T2 = {1}
+    cache.put(2, 2); // T1 = {2}
+    cache.put(3, 3); // full: 2 demoted to B1
+    assert(!contains(cache, 2));
+    assert(cache.targetRecencySize() == 0);
+
+    // Re-requesting 2 hits B1, so T1 deserved more room.
+    cache.put(2, 2);
+    assert(cache.targetRecencySize() == 1);
+    assert(contains(cache, 2));
+    assert(cache.size() == 2);
+}
+
+void testGhostsAreMisses() {
+    ArcCache<int, int> cache(1);
+    cache.put(1, 1);
+    cache.get(1);
+    cache.put(2, 2);
+    bool exception_caught = false;
+    try {
+        cache.get(1);
+    } catch (const std::out_of_range&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+void testPolicySelection() {
+    PolicyCache<int, std::string, cache_policy::ArcPolicy> arc(2);
+    PolicyCache<int, std::string> lru(2);
+    static_assert(std::is_same_v<decltype(arc), ArcCache<int, std::string>>);
+    static_assert(std::is_same_v<decltype(lru), LruCacheLinkedList<int, std::string>>);
+    arc.put(1, "one");
+    lru.put(1, "one");
+    assert(arc.get(1) == lru.get(1));
+}
+
+template <typename Policy>
+double hitRatio(const size_t capacity, const std::vector<uint64_t>& trace) {
+    PolicyCache<uint64_t, uint64_t, Policy> cache(capacity);
+    return cache_traces::hitRatio(cache, trace);
+}
+
+void benchmarkHitRatio() {
+    constexpr size_t capacity = 5000;
+    constexpr size_t keySpace = 50000;
+    constexpr size_t length = 300000;
+
+    struct Shape {
+        std::string name;
+        std::vector<uint64_t> trace;
+    };
+    // The last shape switches phase halfway: a loop, then a skewed workload.
+    auto phased = cache_traces::loop(length / 2, 6000);
+    const auto zipfPhase = cache_traces::zipf(length / 2, keySpace, 1.0, 2);
+    phased.insert(phased.end(), zipfPhase.begin(), zipfPhase.end());
+
+    const std::vector<Shape> shapes = {
+        {"zipf 0.9", cache_traces::zipf(length, keySpace, 0.9)},
+        {"loop 6000", cache_traces::loop(length, 6000)},
+        {"zipf+scans", cache_traces::scanMixed(length, keySpace, 0.9, 20000, 20000)},
+        {"loop->zipf", phased},
+    };
+
+    std::cout << "\nHit ratio, capacity " << capacity << std::endl;
+    std::cout << "trace\t\tLRU\t\tCLOCK\t\tARC\t\tW-TinyLFU" << std::endl;
+    for (const auto& shape : shapes) {
+        std::cout << shape.name << "\t"
+                  << hitRatio<cache_policy::LruPolicy>(capacity, shape.trace) << "\t"
+                  << hitRatio<cache_policy::ClockPolicy>(capacity, shape.trace) << "\t"
+                  << hitRatio<cache_policy::ArcPolicy>(capacity, shape.trace) << "\t"
+                  << hitRatio<cache_policy::TinyLfuPolicy>(capacity, shape.trace) << std::endl;
+    }
+}
+
+int main() {
+    test("Frequent Keys Survive Scan", testFrequentKeysSurviveScan);
+    test("Ghost Hit Grows Recency Target", testGhostHitGrowsRecencyTarget);
+    test("Ghosts Are Misses", testGhostsAreMisses);
+    test("Policy Selection", testPolicySelection);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkHitRatio();
+    return 0;
+}
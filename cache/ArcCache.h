@@ -0,0 +1,190 @@
+#ifndef CPP_DATASTRUCTURES_ARCCACHE_H
+#define CPP_DATASTRUCTURES_ARCCACHE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+/**
+ * @brief An Adaptive Replacement Cache (Megiddo & Modha, FAST '03).
+ *
+ * ARC splits the cache between keys seen once recently (T1) and keys seen at
+ * least twice (T2), and remembers the keys it recently evicted from each in
+ * ghost lists B1 and B2 (keys only, no values). A miss that hits B1 means T1
+ * was too small, so the target size p of T1 grows; a hit in B2 shrinks it.
+ * The cache therefore shifts between LRU-like behaviour for recency-heavy
+ * phases and LFU-like behaviour for frequency-heavy phases without tuning,
+ * and a one-off scan can only flush T1.
+ *
+ * The interface matches LruCacheLinkedList: get only serves resident entries
+ * and throws on a miss, and put performs the ARC replacement for new keys.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The cached value type.
+ * @tparam Hash The hash functor for Key.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ArcCache {
+private:
+    enum class Where { T1, T2, B1, B2 };
+
+    struct CacheEntry {
+        Where where;
+        typename std::list<Key>::iterator list_iterator;
+        // Present for T1/T2 entries, empty for ghosts.
+        std::optional<Value> value;
+    };
+
+public:
+    // Constructor to set the maximum number of resident entries.
+    explicit ArcCache(const size_t capacity) : _capacity(capacity) {}
+
+    /**
+     * @brief Gets the value associated with a resident key and promotes it to
+     * the MRU end of T2.
+     *
+     * @param key The key to look up.
+     * @return The value associated with the key.
+     * @throws std::out_of_range if the key is not resident (ghosts are misses).
+     */
+    Value get(const Key& key) {
+        auto it = _cache.find(key);
+        if (it == _cache.end() || !isResident(it->second.where)) {
+            throw std::out_of_range("Key not found in cache.");
+        }
+        moveTo(it->second, Where::T2);
+        return *it->second.value;
+    }
+
+    /**
+     * @brief Inserts or updates a key-value pair.
+     *
+     * A resident key is updated and promoted to T2. A key remembered in a ghost
+     * list adapts the T1 target and re-enters the cache in T2. A brand-new key
+     * enters T1, after making room according to the ARC rules.
+     *
+     * @param key The key to insert or update.
+     * @param value The value associated with the key.
+     */
+    void put(const Key& key, const Value& value) {
+        // Check for edge case of 0 capacity
+        if (_capacity == 0) {
+            return;
+        }
+
+        auto it = _cache.find(key);
+        if (it != _cache.end()) {
+            CacheEntry& entry = it->second;
+            switch (entry.where) {
+                case Where::T1:
+                case Where::T2:
+                    entry.value = value;
+                    moveTo(entry, Where::T2);
+                    return;
+                case Where::B1:
+                    _p = std::min(_capacity, _p + std::max<size_t>(_b2.size() / _b1.size(), 1));
+                    replace(false);
+                    break;
+                case Where::B2:
+                    _p -= std::min(_p, std::max<size_t>(_b1.size() / _b2.size(), 1));
+                    replace(true);
+                    break;
+            }
+            entry.value = value;
+            moveTo(entry, Where::T2);
+            return;
+        }
+
+        const size_t l1 = _t1.size() + _b1.size();
+        const size_t total = l1 + _t2.size() + _b2.size();
+        if (l1 == _capacity) {
+            if (_t1.size() < _capacity) {
+                dropLru(_b1);
+                replace(false);
+            } else {
+                dropLru(_t1);
+            }
+        } else if (total >= _capacity) {
+            if (total == 2 * _capacity) {
+                dropLru(_b2);
+            }
+            replace(false);
+        }
+
+        _t1.emplace_front(key);
+        _cache.insert({key, CacheEntry{Where::T1, _t1.begin(), value}});
+    }
+
+    /**
+     * @brief Returns the number of resident entries.
+     */
+    size_t size() const { return _t1.size() + _t2.size(); }
+
+    /**
+     * @brief Returns the current adaptive target size of T1.
+     */
+    size_t targetRecencySize() const { return _p; }
+
+private:
+    static bool isResident(const Where where) { return where == Where::T1 || where == Where::T2; }
+
+    std::list<Key>& listFor(const Where where) {
+        switch (where) {
+            case Where::T1: return _t1;
+            case Where::T2: return _t2;
+            case Where::B1: return _b1;
+            default: return _b2;
+        }
+    }
+
+    // Moves an entry to the MRU end of the given list.
+    void moveTo(CacheEntry& entry, const Where where) {
+        std::list<Key>& to = listFor(where);
+        to.splice(to.begin(), listFor(entry.where), entry.list_iterator);
+        entry.where = where;
+    }
+
+    // Forgets the LRU key of a list entirely.
+    void dropLru(std::list<Key>& list) {
+        _cache.erase(list.back());
+        list.pop_back();
+    }
+
+    // Demotes the LRU entry of T1 or T2 to its ghost list, following the
+    // target p. requestInB2 is true when the current request hit B2.
+    void replace(const bool requestInB2) {
+        if (!_t1.empty() && ((requestInB2 && _t1.size() == _p) || _t1.size() > _p)) {
+            demoteLru(Where::T1, Where::B1);
+        } else if (!_t2.empty()) {
+            demoteLru(Where::T2, Where::B2);
+        } else if (!_t1.empty()) {
+            demoteLru(Where::T1, Where::B1);
+        }
+    }
+
+    void demoteLru(const Where from, const Where ghost) {
+        CacheEntry& entry = _cache.find(listFor(from).back())->second;
+        entry.value.reset();
+        moveTo(entry, ghost);
+    }
+
+    // Resident lists: seen once recently (T1) and seen at least twice (T2).
+    std::list<Key> _t1, _t2;
+
+    // Ghost lists: keys recently evicted from T1 and T2.
+    std::list<Key> _b1, _b2;
+
+    // Key to its list, position and (if resident) value.
+    std::unordered_map<Key, CacheEntry, Hash> _cache;
+
+    size_t _capacity;
+
+    // Adaptive target size of T1.
+    size_t _p = 0;
+};
+
+#endif //CPP_DATASTRUCTURES_ARCCACHE_H
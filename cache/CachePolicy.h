@@ -0,0 +1,45 @@
+#ifndef CPP_DATASTRUCTURES_CACHEPOLICY_H
+#define CPP_DATASTRUCTURES_CACHEPOLICY_H
+
+#include "ArcCache.h"
+#include "ClockCache.h"
+#include "LruCacheLinkedList.h"
+#include "TinyLfuCache.h"
+
+/**
+ * @brief Compile-time selection of a cache replacement policy.
+ *
+ * Every policy exposes the same get/put interface, so call sites can be
+ * written once against PolicyCache and switched between policies by changing
+ * a template argument, with no virtual dispatch:
+ *
+ *     PolicyCache<int, std::string, ArcPolicy> cache(1024);
+ */
+namespace cache_policy {
+
+struct LruPolicy {
+    template <typename Key, typename Value>
+    using cache = LruCacheLinkedList<Key, Value>;
+};
+
+struct ClockPolicy {
+    template <typename Key, typename Value>
+    using cache = ClockCache<Key, Value>;
+};
+
+struct ArcPolicy {
+    template <typename Key, typename Value>
+    using cache = ArcCache<Key, Value>;
+};
+
+struct TinyLfuPolicy {
+    template <typename Key, typename Value>
+    using cache = TinyLfuCache<Key, Value>;
+};
+
+} // namespace cache_policy
+
+template <typename Key, typename Value, typename Policy = cache_policy::LruPolicy>
+using PolicyCache = typename Policy::template cache<Key, Value>;
+
+#endif //CPP_DATASTRUCTURES_CACHEPOLICY_H
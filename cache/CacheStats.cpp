@@ -0,0 +1,181 @@
+#include "CacheStats.h"
+#include "CacheTraces.h"
+#include "LruCacheLinkedList.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+// Times every call so latency counts are exact.
+using InstrumentedCache = LruCacheLinkedList<int, std::string, cache_stats::BasicCacheStats<1>>;
+
+void testCountsOperations() {
+    InstrumentedCache cache(2);
+    cache.put(1, "a");
+    cache.put(2, "bb");
+    cache.put(1, "aaa");    // update
+    cache.put(3, "cccc");   // evicts 2
+    cache.get(1);
+    try {
+        cache.get(2);
+    } catch (const std::out_of_range&) {
+    }
+
+    const cache_stats::Snapshot stats = cache.stats();
+    assert(stats.inserts == 3);
+    assert(stats.updates == 1);
+    assert(stats.evictions == 1);
+    assert(stats.bytesEvicted == 2);
+    assert(stats.hits == 1);
+    assert(stats.misses == 1);
+    assert(stats.hitRatio() == 0.5);
+    assert(stats.getLatency.count() == 2);
+    assert(stats.putLatency.count() == 4);
+}
+
+void testLatencyIsSampled() {
+    LruCacheLinkedList<int, int, cache_stats::BasicCacheStats<8>> cache(16);
+    for (int i = 0; i < 64; ++i) {
+        cache.put(i % 16, i);
+    }
+    const cache_stats::Snapshot stats = cache.stats();
+    assert(stats.putLatency.count() == 8);
+    assert(stats.inserts + stats.updates == 64);
+}
+
+void testBatchLookupsAndExplicitEvictions() {
+    LruCacheLinkedList<int, int, cache_stats::CacheStats> cache(4);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    const std::vector<int> keys = {1, 3, 2};
+    std::vector<std::optional<int>> out(keys.size());
+    cache.getMany(keys, out);
+    cache.evictLeastRecent();
+
+    const cache_stats::Snapshot stats = cache.stats();
+    assert(stats.hits == 2);
+    assert(stats.misses == 1);
+    assert(stats.evictions == 1);
+    assert(stats.bytesEvicted == sizeof(int));
+}
+
+void testHistogramBuckets() {
+    using cache_stats::CacheStats;
+    static_assert(std::is_same_v<CacheStats, cache_stats::BasicCacheStats<64>>);
+    assert(CacheStats::bucketFor(0) == 0);
+    assert(CacheStats::bucketFor(1) == 0);
+    assert(CacheStats::bucketFor(2) == 1);
+    assert(CacheStats::bucketFor(1023) == 9);
+    assert(CacheStats::bucketFor(1024) == 10);
+    assert(CacheStats::bucketFor(UINT64_MAX) == cache_stats::kLatencyBuckets - 1);
+
+    cache_stats::LatencyHistogram histogram;
+    histogram.buckets[4] = 90;  // 16-31 ns
+    histogram.buckets[10] = 10; // 1-2 us
+    assert(histogram.quantileUpperBound(0.5) == 32);
+    assert(histogram.quantileUpperBound(0.9) == 32);
+    assert(histogram.quantileUpperBound(0.99) == 2048);
+    assert(cache_stats::LatencyHistogram{}.quantileUpperBound(0.99) == 0);
+}
+
+void testAggregatesAcrossThreads() {
+    cache_stats::CacheStats stats;
+    constexpr int threads = 8;
+    constexpr int perThread = 100000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&stats] {
+            for (int i = 0; i < perThread; ++i) {
+                stats.recordHit();
+                if (i % 4 == 0) stats.recordMiss();
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    const cache_stats::Snapshot snapshot = stats.snapshot();
+    assert(snapshot.hits == threads * perThread);
+    assert(snapshot.misses == threads * perThread / 4);
+}
+
+void testDisabledStatsAreFree() {
+    static_assert(std::is_empty_v<cache_stats::NoStats>);
+    struct Bare {
+        std::list<int> orders;
+        std::unordered_map<int, std::pair<int, std::list<int>::iterator>> cache;
+        size_t capacity;
+    };
+    static_assert(sizeof(LruCacheLinkedList<int, int>) == sizeof(Bare));
+
+    LruCacheLinkedList<int, int> cache(1);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    assert(cache.stats().inserts == 0);
+}
+
+uint64_t benchmarkSink = 0;
+
+template <typename Cache>
+double opsPerSecond(Cache& cache, const std::vector<uint64_t>& trace) {
+    uint64_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const uint64_t key : trace) {
+        if (cache.contains(key)) {
+            sink += cache.get(key);
+        } else {
+            cache.put(key, key);
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink += sink;
+    return trace.size() / elapsed.count();
+}
+
+void benchmarkOverhead() {
+    constexpr size_t capacity = 1 << 16;
+    const auto trace = cache_traces::zipf(4000000, 1 << 20, 0.9);
+    LruCacheLinkedList<uint64_t, uint64_t> plain(capacity);
+    LruCacheLinkedList<uint64_t, uint64_t, cache_stats::CacheStats> instrumented(capacity);
+    const double plainOps = opsPerSecond(plain, trace);
+    const double instrumentedOps = opsPerSecond(instrumented, trace);
+    const cache_stats::Snapshot stats = instrumented.stats();
+
+    std::cout << "\nLruCacheLinkedList, 4M zipf 0.9 lookups" << std::endl;
+    std::cout << "NoStats\t\t" << plainOps / 1e6 << " Mops/s" << std::endl;
+    std::cout << "CacheStats\t" << instrumentedOps / 1e6 << " Mops/s" << std::endl;
+    std::cout << "evictions " << stats.evictions << ", get p50 <= " << stats.getLatency.quantileUpperBound(0.5)
+              << " ns, get p99 <= " << stats.getLatency.quantileUpperBound(0.99)
+              << " ns, put p99 <= " << stats.putLatency.quantileUpperBound(0.99) << " ns" << std::endl;
+}
+
+int main() {
+    test("Counts Operations", testCountsOperations);
+    test("Latency Is Sampled", testLatencyIsSampled);
+    test("Batch Lookups And Explicit Evictions", testBatchLookupsAndExplicitEvictions);
+    test("Histogram Buckets", testHistogramBuckets);
+    test("Aggregates Across Threads", testAggregatesAcrossThreads);
+    test("Disabled Stats Are Free", testDisabledStatsAreFree);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkOverhead();
+    return 0;
+}
@@ -0,0 +1,256 @@
+#ifndef CPP_DATASTRUCTURES_CACHESTATS_H
+#define CPP_DATASTRUCTURES_CACHESTATS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+/**
+ * @brief Opt-in instrumentation for the caches.
+ *
+ * A cache takes its stats type as a template parameter. NoStats, the default,
+ * is an empty type whose hooks are empty inline functions, so an
+ * uninstrumented cache compiles to the same code and layout as before.
+ * CacheStats counts hits, misses, inserts, updates, evictions and evicted
+ * bytes, and keeps log2-bucketed latency histograms for get and put.
+ *
+ * CacheStats spreads the counters over slots on separate cache lines, one
+ * per hardware thread up to 16, and only sums them when snapshot is called.
+ * Threads are dealt to slots round-robin, so recording takes no lock and
+ * threads contend only when more of them record than there are slots; those
+ * sharing a slot still bounce its line. Each slot is about 600 bytes, mostly
+ * latency histograms. Reading the clock costs more than the counters, so
+ * latency is sampled: one call in SamplePeriod per thread is timed.
+ */
+namespace cache_stats {
+
+// Bucket b counts latencies in [2^b, 2^(b+1)) nanoseconds; bucket 0 also
+// holds 0 ns and the last bucket everything above its lower bound.
+inline constexpr size_t kLatencyBuckets = 32;
+
+struct LatencyHistogram {
+    std::array<uint64_t, kLatencyBuckets> buckets{};
+
+    uint64_t count() const {
+        uint64_t total = 0;
+        for (const uint64_t b : buckets) {
+            total += b;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Returns an upper bound, in nanoseconds, on the given quantile,
+     * or 0 if nothing was recorded.
+     * @param q The quantile in [0, 1], e.g. 0.99.
+     */
+    uint64_t quantileUpperBound(const double q) const {
+        const uint64_t total = count();
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+        uint64_t seen = 0;
+        for (size_t b = 0; b < kLatencyBuckets; ++b) {
+            seen += buckets[b];
+            if (seen >= rank) {
+                return uint64_t{2} << b;
+            }
+        }
+        return 0;
+    }
+};
+
+/**
+ * @brief A point-in-time copy of a cache's statistics, ready for export.
+ */
+struct Snapshot {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t inserts = 0;
+    uint64_t updates = 0;
+    uint64_t evictions = 0;
+    uint64_t bytesEvicted = 0;
+    LatencyHistogram getLatency;
+    LatencyHistogram putLatency;
+
+    double hitRatio() const {
+        const uint64_t lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+/**
+ * @brief Returns the bytes a value accounts for: the payload of contiguous
+ * containers such as std::string, and sizeof(Value) for anything else.
+ */
+template <typename Value>
+size_t valueBytes(const Value& value) {
+    if constexpr (requires { value.size(); value.data(); }) {
+        return value.size() * sizeof(*value.data());
+    } else {
+        return sizeof(Value);
+    }
+}
+
+/**
+ * @brief The disabled stats layer: every hook is a no-op.
+ */
+struct NoStats {
+    static constexpr bool enabled = false;
+
+    struct Timer {};
+
+    Timer timeGet() { return {}; }
+    Timer timePut() { return {}; }
+    void recordHit() {}
+    void recordMiss() {}
+    void recordInsert() {}
+    void recordUpdate() {}
+    template <typename Value>
+    void recordEviction(const Value&) {}
+
+    Snapshot snapshot() const { return {}; }
+};
+
+/**
+ * @brief The enabled stats layer.
+ *
+ * @tparam SamplePeriod One in this many get/put calls per thread is timed;
+ *         1 times every call.
+ */
+template <uint32_t SamplePeriod>
+class BasicCacheStats {
+    static_assert(SamplePeriod > 0, "SamplePeriod must be positive");
+
+private:
+    static constexpr size_t kMaxSlots = 16;
+
+    using Counter = std::atomic<uint64_t>;
+
+    struct alignas(64) Slot {
+        Counter hits{0};
+        Counter misses{0};
+        Counter inserts{0};
+        Counter updates{0};
+        Counter evictions{0};
+        Counter bytesEvicted{0};
+        std::array<Counter, kLatencyBuckets> getLatency{};
+        std::array<Counter, kLatencyBuckets> putLatency{};
+    };
+
+public:
+    static constexpr bool enabled = true;
+
+    BasicCacheStats() : _slotMask(slotCount() - 1), _slots(std::make_unique<Slot[]>(slotCount())) {}
+
+    /**
+     * @brief Records the time from construction to destruction into a latency
+     * histogram, or does nothing if constructed with nullptr.
+     */
+    class Timer {
+    public:
+        explicit Timer(std::array<Counter, kLatencyBuckets>* histogram) : _histogram(histogram) {
+            if (_histogram) {
+                _start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~Timer() {
+            if (!_histogram) {
+                return;
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - _start;
+            const auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            (*_histogram)[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+    private:
+        std::array<Counter, kLatencyBuckets>* _histogram;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    Timer timeGet() { return Timer(sampled() ? &slot().getLatency : nullptr); }
+    Timer timePut() { return Timer(sampled() ? &slot().putLatency : nullptr); }
+    void recordHit() { add(slot().hits, 1); }
+    void recordMiss() { add(slot().misses, 1); }
+    void recordInsert() { add(slot().inserts, 1); }
+    void recordUpdate() { add(slot().updates, 1); }
+
+    template <typename Value>
+    void recordEviction(const Value& value) {
+        Slot& s = slot();
+        add(s.evictions, 1);
+        add(s.bytesEvicted, valueBytes(value));
+    }
+
+    /**
+     * @brief Sums the slots. Counters recorded concurrently may or
+     * may not be included.
+     */
+    Snapshot snapshot() const {
+        Snapshot result;
+        for (size_t i = 0; i <= _slotMask; ++i) {
+            const Slot& s = _slots[i];
+            result.hits += s.hits.load(std::memory_order_relaxed);
+            result.misses += s.misses.load(std::memory_order_relaxed);
+            result.inserts += s.inserts.load(std::memory_order_relaxed);
+            result.updates += s.updates.load(std::memory_order_relaxed);
+            result.evictions += s.evictions.load(std::memory_order_relaxed);
+            result.bytesEvicted += s.bytesEvicted.load(std::memory_order_relaxed);
+            for (size_t b = 0; b < kLatencyBuckets; ++b) {
+                result.getLatency.buckets[b] += s.getLatency[b].load(std::memory_order_relaxed);
+                result.putLatency.buckets[b] += s.putLatency[b].load(std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the histogram bucket for a latency in nanoseconds.
+     */
+    static size_t bucketFor(const uint64_t ns) {
+        const size_t b = ns == 0 ? 0 : static_cast<size_t>(std::bit_width(ns)) - 1;
+        return b < kLatencyBuckets ? b : kLatencyBuckets - 1;
+    }
+
+private:
+    static bool sampled() {
+        if constexpr (SamplePeriod == 1) {
+            return true;
+        } else {
+            thread_local uint32_t calls = 0;
+            return ++calls % SamplePeriod == 0;
+        }
+    }
+
+    static void add(Counter& counter, const uint64_t n) { counter.fetch_add(n, std::memory_order_relaxed); }
+
+    // A power of two, so a thread's number can be masked to a slot.
+    static size_t slotCount() {
+        return std::min(kMaxSlots, std::bit_ceil(static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()))));
+    }
+
+    // Threads are numbered on first use and spread round-robin over the slots.
+    Slot& slot() {
+        static std::atomic<size_t> nextThread{0};
+        thread_local const size_t index = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return _slots[index & _slotMask];
+    }
+
+    size_t _slotMask;
+    std::unique_ptr<Slot[]> _slots;
+};
+
+using CacheStats = BasicCacheStats<64>;
+
+} // namespace cache_stats
+
+#endif //CPP_DATASTRUCTURES_CACHESTATS_H
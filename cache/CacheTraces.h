@@ -0,0 +1,109 @@
+#ifndef CPP_DATASTRUCTURES_CACHETRACES_H
+#define CPP_DATASTRUCTURES_CACHETRACES_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Synthetic access traces shared by the cache benchmarks.
+ *
+ * All generators are deterministic for a given seed so that different cache
+ * policies can be compared on identical inputs.
+ */
+namespace cache_traces {
+
+/**
+ * @brief Generates keys in [0, keySpace) following a Zipf distribution.
+ *
+ * Key k is drawn with probability proportional to 1 / (k + 1)^skew, so small
+ * keys are hot. Sampling uses a precomputed CDF and binary search.
+ *
+ * @param length Number of accesses to generate.
+ * @param keySpace Number of distinct keys.
+ * @param skew The Zipf exponent; 0 is uniform, ~1 is typical web traffic.
+ * @param seed RNG seed.
+ */
+inline std::vector<uint64_t> zipf(const size_t length, const size_t keySpace, const double skew,
+                                  const uint32_t seed = 1) {
+    std::vector<double> cdf(keySpace);
+    double total = 0;
+    for (size_t k = 0; k < keySpace; ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), skew);
+        cdf[k] = total;
+    }
+
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, total);
+    std::vector<uint64_t> trace(length);
+    for (auto& key : trace) {
+        key = std::lower_bound(cdf.begin(), cdf.end(), unit(rng)) - cdf.begin();
+    }
+    return trace;
+}
+
+/**
+ * @brief Generates a cyclic scan over [0, loopSize), repeated until length.
+ *
+ * When loopSize exceeds the cache size, LRU gets a 0% hit ratio on this shape.
+ */
+inline std::vector<uint64_t> loop(const size_t length, const size_t loopSize) {
+    std::vector<uint64_t> trace(length);
+    for (size_t i = 0; i < length; ++i) {
+        trace[i] = i % loopSize;
+    }
+    return trace;
+}
+
+/**
+ * @brief A Zipf workload interrupted by periodic one-off scans.
+ *
+ * Every `period` accesses, a burst of `scanLength` never-repeated keys is
+ * injected. The scan keys start above keySpace so they never collide with the
+ * hot set.
+ */
+inline std::vector<uint64_t> scanMixed(const size_t length, const size_t keySpace, const double skew,
+                                       const size_t period, const size_t scanLength,
+                                       const uint32_t seed = 1) {
+    const auto base = zipf(length, keySpace, skew, seed);
+    std::vector<uint64_t> trace;
+    trace.reserve(length + (length / period + 1) * scanLength);
+
+    uint64_t nextScanKey = keySpace;
+    for (size_t i = 0; i < length; ++i) {
+        if (i % period == 0 && i != 0) {
+            for (size_t s = 0; s < scanLength; ++s) {
+                trace.push_back(nextScanKey++);
+            }
+        }
+        trace.push_back(base[i]);
+    }
+    return trace;
+}
+
+/**
+ * @brief Replays a trace as a read-through cache and returns the hit ratio.
+ *
+ * A get that throws std::out_of_range counts as a miss and is followed by a put,
+ * which matches the get/put interface used by every cache in this directory.
+ */
+template <typename Cache>
+double hitRatio(Cache& cache, const std::vector<uint64_t>& trace) {
+    size_t hits = 0;
+    for (const auto key : trace) {
+        try {
+            cache.get(key);
+            ++hits;
+        } catch (const std::out_of_range&) {
+            cache.put(key, key);
+        }
+    }
+    return trace.empty() ? 0.0 : static_cast<double>(hits) / trace.size();
+}
+
+} // namespace cache_traces
+
+#endif //CPP_DATASTRUCTURES_CACHETRACES_H
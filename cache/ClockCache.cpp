@@ -0,0 +1,177 @@
+#include "ClockCache.h"
+#include "CacheTraces.h"
+#include "GlobalLockLruCache.h"
+#include "LruCacheLinkedList.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+bool contains(const ClockCache<int, int>& cache, const int key) {
+    try {
+        cache.get(key);
+        return true;
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+}
+
+void testSecondChance() {
+    ClockCache<int, int> cache(3);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+    cache.get(1);
+    cache.get(2);
+
+    // 1 and 2 are referenced, so the hand clears them and evicts 3.
+    cache.put(4, 4);
+    assert(!contains(cache, 3));
+
+    // The sweep cleared both bits. Touch 1 again so that 2 is the next
+    // unreferenced slot the hand reaches.
+    cache.get(1);
+    cache.put(5, 5);
+    assert(contains(cache, 1));
+    assert(!contains(cache, 2));
+    assert(cache.size() == 3);
+}
+
+void testAllReferencedEvictsAfterFullRevolution() {
+    ClockCache<int, int> cache(2);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.get(1);
+    cache.get(2);
+    cache.put(3, 3);
+    assert(cache.size() == 2);
+    assert(contains(cache, 3));
+}
+
+void testConcurrentReadersAndWriter() {
+    ClockCache<int, int> cache(256);
+    for (int i = 0; i < 256; ++i) {
+        cache.put(i, i);
+    }
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&cache, &stop, t] {
+            int i = t;
+            while (!stop.load()) {
+                try {
+                    const int key = i++ % 512;
+                    const int value = cache.get(key);
+                    assert(value % 512 == key);
+                } catch (const std::out_of_range&) {
+                }
+            }
+        });
+    }
+    // Values change on every lap, so readers also race with in-place updates.
+    for (int i = 0; i < 100000; ++i) {
+        cache.put(i % 512, i);
+    }
+    stop = true;
+    for (auto& r : readers) {
+        r.join();
+    }
+    assert(cache.size() == 256);
+}
+
+void benchmarkHitRatio() {
+    constexpr size_t keySpace = 100000;
+    constexpr size_t length = 300000;
+    std::cout << "\nHit ratio, " << keySpace << " keys, " << length << " accesses" << std::endl;
+    std::cout << "skew\tcache\tLRU\tCLOCK" << std::endl;
+    for (const double skew : {0.7, 0.9, 1.1}) {
+        const auto trace = cache_traces::zipf(length, keySpace, skew);
+        for (const size_t capacity : {1000, 10000}) {
+            LruCacheLinkedList<uint64_t, uint64_t> lru(capacity);
+            ClockCache<uint64_t, uint64_t> clock(capacity);
+            std::cout << skew << "\t" << capacity << "\t"
+                      << cache_traces::hitRatio(lru, trace) << "\t"
+                      << cache_traces::hitRatio(clock, trace) << std::endl;
+        }
+    }
+}
+
+std::atomic<uint64_t> benchmarkSink{0};
+
+// Every thread replays its own Zipf trace against a cache prefilled with the
+// whole key space; 5% of operations are puts, the rest are hits.
+template <typename Cache>
+double runReadHeavy(Cache& cache, const int threads, const std::vector<std::vector<uint64_t>>& traces) {
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&cache, &trace = traces[t]] {
+            uint64_t sink = 0;
+            for (size_t i = 0; i < trace.size(); ++i) {
+                if (i % 20 == 0) {
+                    cache.put(trace[i], i);
+                } else {
+                    sink += cache.get(trace[i]);
+                }
+            }
+            benchmarkSink += sink;
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threads * static_cast<double>(traces[0].size()) / elapsed.count() / 1e6;
+}
+
+void benchmarkThroughput() {
+    constexpr size_t keySpace = 1 << 16;
+    constexpr size_t opsPerThread = 200000;
+    std::cout << "\nThroughput (Mops/s), 95% hits, Zipf 0.9, hardware threads: "
+              << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "threads\tglobal-lock LRU\tCLOCK" << std::endl;
+
+    std::vector<std::vector<uint64_t>> traces;
+    for (int t = 0; t < 32; ++t) {
+        traces.push_back(cache_traces::zipf(opsPerThread, keySpace, 0.9, t + 1));
+    }
+
+    for (int threads = 1; threads <= 32; threads *= 2) {
+        GlobalLockLruCache<uint64_t, uint64_t> lru(keySpace);
+        ClockCache<uint64_t, uint64_t> clock(keySpace);
+        for (uint64_t k = 0; k < keySpace; ++k) {
+            lru.put(k, k);
+            clock.put(k, k);
+        }
+        const double lruOps = runReadHeavy(lru, threads, traces);
+        const double clockOps = runReadHeavy(clock, threads, traces);
+        std::cout << threads << "\t" << lruOps << "\t\t" << clockOps << std::endl;
+    }
+}
+
+int main() {
+    test("Second Chance", testSecondChance);
+    test("All Referenced Evicts After Full Revolution", testAllReferencedEvictsAfterFullRevolution);
+    test("Concurrent Readers And Writer", testConcurrentReadersAndWriter);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkHitRatio();
+    benchmarkThroughput();
+    return 0;
+}
@@ -0,0 +1,216 @@
+#ifndef CPP_DATASTRUCTURES_CLOCKCACHE_H
+#define CPP_DATASTRUCTURES_CLOCKCACHE_H
+
+#include "../concurrency/Reclamation.h"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief A thread-safe cache using the CLOCK (second chance) eviction policy,
+ * with lock-free hits.
+ *
+ * Entries live in a fixed ring of `capacity` slots, each with a reference bit.
+ * The index is a fixed array of buckets, each a chain of immutable nodes
+ * holding a key, its value and its slot. A hit walks one chain inside an
+ * epoch guard (reclamation::Epoch) and sets the slot's reference bit with a
+ * relaxed store: no lock and no read-modify-write on a shared line, so
+ * readers never serialize on a reader count the way they would under a
+ * shared_mutex.
+ *
+ * Writers take a mutex. Replacing a value links a new node in place of the
+ * old one, and eviction unlinks the victim's node; either way the old node is
+ * retired to the epoch domain and freed once no reader can still hold it. On
+ * a miss with a full cache, the clock hand sweeps around the ring: referenced
+ * slots have their bit cleared and are skipped, and the first unreferenced
+ * slot is evicted. This approximates LRU closely on skewed workloads.
+ *
+ * @tparam Key The key type. Must be hashable by Hash and comparable with ==.
+ * @tparam Value The cached value type. Must be copy constructible.
+ * @tparam Hash The hash functor for Key.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ClockCache {
+public:
+    /**
+     * @brief Constructs the cache with all slots and buckets preallocated.
+     * @param capacity Maximum number of entries.
+     */
+    explicit ClockCache(const size_t capacity)
+        : _slots(capacity, nullptr),
+          _referenced(std::make_unique<std::atomic<uint8_t>[]>(capacity)),
+          _buckets(std::make_unique<std::atomic<Node*>[]>(std::bit_ceil(capacity | 1))),
+          _bucketMask(std::bit_ceil(capacity | 1) - 1),
+          _capacity(capacity) {}
+
+    ClockCache(const ClockCache&) = delete;
+    ClockCache& operator=(const ClockCache&) = delete;
+
+    ~ClockCache() {
+        for (Node* node : _slots) {
+            delete node;
+        }
+    }
+
+    /**
+     * @brief Gets the value associated with a key and marks it referenced.
+     *
+     * Takes no lock; the reference bit is written only when it is not
+     * already set, so a hot key does not bounce its cache line between
+     * readers. A reader racing with an eviction may set the bit of the
+     * slot's next occupant, which only gives that entry one extra chance.
+     *
+     * @param key The key to look up.
+     * @return The value associated with the key.
+     * @throws std::out_of_range if the key is not in the cache.
+     */
+    Value get(const Key& key) const {
+        reclamation::Epoch::Guard guard;
+        for (const Node* node = guard.protect(bucket(key)); node != nullptr;
+             node = node->next.load(std::memory_order_acquire)) {
+            if (node->key == key) {
+                std::atomic<uint8_t>& bit = _referenced[node->slot];
+                if (bit.load(std::memory_order_relaxed) == 0) {
+                    bit.store(1, std::memory_order_relaxed);
+                }
+                return node->value;
+            }
+        }
+        throw std::out_of_range("Key not found in cache.");
+    }
+
+    /**
+     * @brief Inserts or updates a key-value pair in the cache.
+     *
+     * If the key is new and the cache is full, the clock hand sweeps to the
+     * first unreferenced entry and replaces it. New entries start unreferenced
+     * so that keys seen only once are the first to go.
+     *
+     * @param key The key to insert or update.
+     * @param value The value associated with the key.
+     */
+    void put(const Key& key, const Value& value) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        std::atomic<Node*>& head = bucket(key);
+        if (std::atomic<Node*>* link = find(head, key)) {
+            Node* old = link->load(std::memory_order_relaxed);
+            Node* replacement = new Node{key, value, old->slot, {}};
+            replacement->next.store(old->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            link->store(replacement, std::memory_order_release);
+            _slots[old->slot] = replacement;
+            _referenced[old->slot].store(1, std::memory_order_relaxed);
+            reclamation::Epoch::Guard().retire(old);
+            return;
+        }
+
+        // Check for edge case of 0 capacity
+        if (_capacity == 0) {
+            return;
+        }
+
+        // Built before a slot is claimed, so a throwing copy leaves the ring as it was.
+        Node* node = new Node{key, value, 0, {}};
+        Node* victim = nullptr;
+        if (_size < _capacity) {
+            node->slot = static_cast<uint32_t>(_size++);
+        } else {
+            node->slot = sweep();
+            victim = _slots[node->slot];
+        }
+
+        const uint32_t slot = node->slot;
+        if (victim != nullptr) {
+            std::atomic<Node*>* link = find(bucket(victim->key), victim->key);
+            link->store(victim->next.load(std::memory_order_relaxed), std::memory_order_release);
+            reclamation::Epoch::Guard().retire(victim);
+        }
+        _slots[slot] = node;
+        _referenced[slot].store(0, std::memory_order_relaxed);
+        node->next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        head.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns the number of entries currently held by the cache.
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(_mtx);
+        return _size;
+    }
+
+    /**
+     * @brief Returns the maximum number of entries the cache will hold.
+     */
+    size_t capacity() const { return _capacity; }
+
+private:
+    // Never changed once linked, except for next, so readers can copy the
+    // value without synchronizing with writers.
+    struct Node {
+        Key key;
+        Value value;
+        uint32_t slot;
+        std::atomic<Node*> next;
+    };
+
+    std::atomic<Node*>& bucket(const Key& key) const {
+        return _buckets[_hash(key) & _bucketMask];
+    }
+
+    // Returns the link that points at key's node in the chain starting at
+    // head, or nullptr if the key is absent. Caller must hold the lock.
+    static std::atomic<Node*>* find(std::atomic<Node*>& head, const Key& key) {
+        for (std::atomic<Node*>* link = &head;;) {
+            Node* node = link->load(std::memory_order_relaxed);
+            if (node == nullptr) {
+                return nullptr;
+            }
+            if (node->key == key) {
+                return link;
+            }
+            link = &node->next;
+        }
+    }
+
+    // Advances the hand until it finds an unreferenced slot, giving every
+    // referenced slot a second chance by clearing its bit. Terminates within
+    // one full revolution. Caller must hold the lock.
+    uint32_t sweep() {
+        while (_referenced[_hand].load(std::memory_order_relaxed) != 0) {
+            _referenced[_hand].store(0, std::memory_order_relaxed);
+            advanceHand();
+        }
+        const uint32_t victim = _hand;
+        advanceHand();
+        return victim;
+    }
+
+    void advanceHand() {
+        if (++_hand == _capacity) {
+            _hand = 0;
+        }
+    }
+
+    // Ring of slots, each owning the node of its entry; positions [0, _size)
+    // are in use.
+    std::vector<Node*> _slots;
+    std::unique_ptr<std::atomic<uint8_t>[]> _referenced;
+
+    // At least one bucket per slot, so chains stay short without ever
+    // rehashing.
+    std::unique_ptr<std::atomic<Node*>[]> _buckets;
+    size_t _bucketMask;
+    [[no_unique_address]] Hash _hash;
+
+    mutable std::mutex _mtx;
+    size_t _size = 0;
+    size_t _capacity;
+    uint32_t _hand = 0;
+};
+
+#endif //CPP_DATASTRUCTURES_CLOCKCACHE_H
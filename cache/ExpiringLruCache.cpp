@@ -0,0 +1,223 @@
+#include "ExpiringLruCache.h"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+// A monotonic clock the tests advance by hand.
+struct ManualClock {
+    using duration = std::chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static inline time_point current{};
+    static time_point now() { return current; }
+    static void advance(const duration d) { current += d; }
+};
+
+using namespace std::chrono_literals;
+
+template <typename Cache>
+bool contains(Cache& cache, const int key) {
+    try {
+        cache.get(key);
+        return true;
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+}
+
+void testWheelFiresInOrder() {
+    TimingWheel<int> wheel;
+    std::vector<int> fired;
+    // Deadlines spanning all four levels, including one past the horizon.
+    const std::vector<uint64_t> deadlines = {1, 63, 64, 65, 4095, 4096, 300000, 20000000};
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        wheel.schedule(static_cast<int>(i), deadlines[i]);
+    }
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        wheel.advance(deadlines[i] - 1, [&fired](const int key) { fired.push_back(key); });
+        assert(fired.size() == i);
+        wheel.advance(deadlines[i], [&fired](const int key) { fired.push_back(key); });
+        assert(fired.size() == i + 1 && fired.back() == static_cast<int>(i));
+    }
+    assert(wheel.size() == 0);
+}
+
+void testWheelCancel() {
+    TimingWheel<int> wheel;
+    auto handle = wheel.schedule(1, 5000);
+    wheel.schedule(2, 5000);
+    wheel.advance(100, [](const int) { assert(false); });
+    // The timer may have cascaded by now; its handle must still be valid.
+    wheel.cancel(handle);
+    std::vector<int> fired;
+    wheel.advance(6000, [&fired](const int key) { fired.push_back(key); });
+    assert(fired.size() == 1 && fired[0] == 2);
+}
+
+void testWheelFiresOnTimeAcrossJumps() {
+    TimingWheel<int> wheel;
+    std::mt19937_64 rng(5);
+    std::vector<uint64_t> deadlines;
+    std::vector<TimingWheel<int>::Handle> handles;
+    std::vector<bool> cancelled;
+    size_t fired = 0;
+    uint64_t previous = 0;
+    for (int round = 0; round < 200; ++round) {
+        // New timers from a few ticks to past the 2^24-tick horizon away.
+        for (int i = 0; i < 20; ++i) {
+            const uint64_t deadline = wheel.now() + 1 + rng() % (uint64_t{1} << (rng() % 26));
+            deadlines.push_back(deadline);
+            handles.push_back(wheel.schedule(static_cast<int>(deadlines.size() - 1), deadline));
+            cancelled.push_back(false);
+        }
+        const size_t victim = rng() % deadlines.size();
+        if (!cancelled[victim] && deadlines[victim] > wheel.now()) {
+            wheel.cancel(handles[victim]);
+            cancelled[victim] = true;
+        }
+        // Mostly short steps, with the odd long idle stretch.
+        const uint64_t to = wheel.now() + (round % 10 == 0 ? rng() % 50000000 : rng() % 5000);
+        wheel.advance(to, [&](const int key) {
+            assert(!cancelled[key]);
+            assert(deadlines[key] > previous && deadlines[key] <= to);
+            ++fired;
+        });
+        previous = to;
+    }
+    wheel.advance(previous + (uint64_t{1} << 27), [&fired](const int) { ++fired; });
+    assert(wheel.size() == 0);
+    assert(fired + static_cast<size_t>(std::count(cancelled.begin(), cancelled.end(), true)) == deadlines.size());
+}
+
+void testEntryExpires() {
+    ExpiringLruCache<int, std::string, ManualClock> cache(10);
+    cache.put(1, "one", 100ms);
+    cache.put(2, "two");
+    ManualClock::advance(99ms);
+    assert(cache.get(1) == "one");
+    ManualClock::advance(1ms);
+    assert(!contains(cache, 1));
+    assert(cache.get(2) == "two");
+    assert(cache.size() == 1);
+}
+
+void testExpiredEntriesReclaimedWithoutGet() {
+    ExpiringLruCache<int, int, ManualClock> cache(1000);
+    for (int i = 0; i < 500; ++i) {
+        cache.put(i, i, std::chrono::milliseconds(10 + i));
+    }
+    assert(cache.expiringCount() == 500);
+    ManualClock::advance(260ms);
+    cache.purgeExpired();
+    // TTLs 10ms..260ms have elapsed: i = 0..250.
+    assert(cache.size() == 249);
+    ManualClock::advance(1s);
+    cache.purgeExpired();
+    assert(cache.size() == 0);
+    assert(cache.expiringCount() == 0);
+}
+
+void testUpdateResetsTtl() {
+    ExpiringLruCache<int, std::string, ManualClock> cache(10);
+    cache.put(1, "one", 50ms);
+    ManualClock::advance(40ms);
+    cache.put(1, "uno", 50ms);
+    ManualClock::advance(40ms);
+    assert(cache.get(1) == "uno");
+
+    // A put without TTL makes the entry permanent.
+    cache.put(1, "ein");
+    ManualClock::advance(1h);
+    assert(cache.get(1) == "ein");
+    assert(cache.expiringCount() == 0);
+}
+
+void testLruEvictionCancelsTimer() {
+    ExpiringLruCache<int, std::string, ManualClock> cache(2);
+    cache.put(1, "one", 10ms);
+    cache.put(2, "two");
+    cache.put(3, "three");
+    assert(!contains(cache, 1));
+    assert(cache.expiringCount() == 0);
+    ManualClock::advance(20ms);
+    assert(cache.get(2) == "two");
+    assert(cache.get(3) == "three");
+}
+
+void testZeroCapacity() {
+    ExpiringLruCache<int, std::string, ManualClock> cache(0);
+    cache.put(1, "one", 10ms);
+    assert(!contains(cache, 1));
+}
+
+void benchmarkExpiryCost() {
+    std::cout << "\nExpiry cost, TTLs uniform in [1s, 60s], 1ms ticks" << std::endl;
+    std::cout << "entries\t\tns per reclaimed entry" << std::endl;
+    for (const int entries : {100000, 1000000, 4000000}) {
+        ExpiringLruCache<int, int, ManualClock> cache(entries);
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<int> ttl(1000, 60000);
+        for (int i = 0; i < entries; ++i) {
+            cache.put(i, i, std::chrono::milliseconds(ttl(rng)));
+        }
+
+        // Reclaim everything in one-second steps, as a periodic sweeper would.
+        const auto start = std::chrono::steady_clock::now();
+        for (int s = 0; s <= 60; ++s) {
+            ManualClock::advance(1s);
+            cache.purgeExpired();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        assert(cache.size() == 0);
+        std::cout << entries << "\t\t" << elapsed.count() / entries << std::endl;
+    }
+}
+
+// One timer ten minutes out at 1ms ticks: advance jumps from one occupied
+// slot to the next instead of stepping through the idle ticks.
+void benchmarkIdleAdvance() {
+    constexpr uint64_t tenMinutes = 600000;
+    TimingWheel<int> wheel;
+    wheel.schedule(0, tenMinutes);
+    size_t fired = 0;
+    const auto start = std::chrono::steady_clock::now();
+    wheel.advance(tenMinutes, [&fired](const int) { ++fired; });
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    assert(fired == 1);
+    std::cout << "\nAdvance over a 10-minute idle at 1ms ticks: " << elapsed.count() << " ns" << std::endl;
+}
+
+int main() {
+    test("Wheel Fires In Order", testWheelFiresInOrder);
+    test("Wheel Cancel", testWheelCancel);
+    test("Wheel Fires On Time Across Jumps", testWheelFiresOnTimeAcrossJumps);
+    test("Entry Expires", testEntryExpires);
+    test("Expired Entries Reclaimed Without Get", testExpiredEntriesReclaimedWithoutGet);
+    test("Update Resets TTL", testUpdateResetsTtl);
+    test("LRU Eviction Cancels Timer", testLruEvictionCancelsTimer);
+    test("Zero Capacity", testZeroCapacity);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkExpiryCost();
+    benchmarkIdleAdvance();
+    return 0;
+}
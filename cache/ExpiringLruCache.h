@@ -0,0 +1,189 @@
+#ifndef CPP_DATASTRUCTURES_EXPIRINGLRUCACHE_H
+#define CPP_DATASTRUCTURES_EXPIRINGLRUCACHE_H
+
+#include "TimingWheel.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <stdexcept>
+#include <unordered_map>
+
+/**
+ * @brief An LRU cache whose entries may carry a time-to-live.
+ *
+ * Works like LruCacheLinkedList, with an extra put overload taking a TTL.
+ * Deadlines are filed in a hierarchical TimingWheel driven by a monotonic
+ * clock, so expired entries are reclaimed in O(1) amortized time each without
+ * scanning the map or maintaining a heap. The wheel is advanced on every get
+ * and put (or explicitly through purgeExpired).
+ *
+ * Expiry is tracked at tick granularity, but get also compares against the
+ * exact deadline, so an entry is never returned after its TTL has elapsed.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The cached value type.
+ * @tparam Clock A monotonic clock with a static now().
+ */
+template <typename Key, typename Value, typename Clock = std::chrono::steady_clock>
+class ExpiringLruCache {
+private:
+    using TimePoint = typename Clock::time_point;
+    using Wheel = TimingWheel<Key>;
+
+    struct CacheEntry {
+        Value value;
+        typename std::list<Key>::iterator list_iterator;
+        bool expires = false;
+        TimePoint expiresAt{};
+        typename Wheel::Handle timer{};
+    };
+
+public:
+    /**
+     * @brief Constructs the cache.
+     * @param capacity Maximum number of entries.
+     * @param tick Granularity of the timing wheel.
+     */
+    explicit ExpiringLruCache(const size_t capacity,
+                              const typename Clock::duration tick = std::chrono::milliseconds(1))
+        : _capacity(capacity), _tick(tick), _epoch(Clock::now()) {}
+
+    /**
+     * @brief Gets the value associated with a key and marks it most recently used.
+     *
+     * @param key The key to look up.
+     * @return The value associated with the key.
+     * @throws std::out_of_range if the key is not in the cache or has expired.
+     */
+    Value get(const Key& key) {
+        const TimePoint now = Clock::now();
+        advanceTo(now);
+
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            throw std::out_of_range("Key not found in cache.");
+        }
+        if (it->second.expires && it->second.expiresAt <= now) {
+            // Past its deadline but not yet reclaimed by the current tick.
+            erase(it);
+            throw std::out_of_range("Key not found in cache.");
+        }
+
+        _orders.splice(_orders.begin(), _orders, it->second.list_iterator);
+        return it->second.value;
+    }
+
+    /**
+     * @brief Inserts or updates a key-value pair that never expires.
+     *
+     * Updating an entry that had a TTL removes the TTL.
+     */
+    void put(const Key& key, const Value& value) {
+        CacheEntry* entry = upsert(key, value);
+        if (entry && entry->expires) {
+            _wheel.cancel(entry->timer);
+            entry->expires = false;
+        }
+    }
+
+    /**
+     * @brief Inserts or updates a key-value pair that expires after ttl.
+     *
+     * @param key The key to insert or update.
+     * @param value The value associated with the key.
+     * @param ttl Time-to-live, measured from now on Clock.
+     */
+    void put(const Key& key, const Value& value, const typename Clock::duration ttl) {
+        CacheEntry* entry = upsert(key, value);
+        if (!entry) {
+            return;
+        }
+        if (entry->expires) {
+            _wheel.cancel(entry->timer);
+        }
+        entry->expires = true;
+        entry->expiresAt = Clock::now() + ttl;
+        entry->timer = _wheel.schedule(key, ticksUntil(entry->expiresAt));
+    }
+
+    /**
+     * @brief Reclaims every entry whose deadline has passed as of the current tick.
+     */
+    void purgeExpired() { advanceTo(Clock::now()); }
+
+    /**
+     * @brief Returns the number of entries held, including expired entries not
+     * yet reclaimed.
+     */
+    size_t size() const { return _cache.size(); }
+
+    /**
+     * @brief Returns the number of entries with a pending TTL.
+     */
+    size_t expiringCount() const { return _wheel.size(); }
+
+private:
+    // Rounds up so that a timer never fires before its deadline.
+    uint64_t ticksUntil(const TimePoint t) const {
+        const auto elapsed = t - _epoch;
+        return static_cast<uint64_t>((elapsed + _tick - typename Clock::duration(1)) / _tick);
+    }
+
+    void advanceTo(const TimePoint now) {
+        const auto ticks = static_cast<uint64_t>((now - _epoch) / _tick);
+        _wheel.advance(ticks, [this](const Key& key) {
+            auto it = _cache.find(key);
+            // The timer has already been removed from the wheel.
+            it->second.expires = false;
+            erase(it);
+        });
+    }
+
+    // Inserts or updates the entry and moves it to the front. Returns nullptr
+    // when nothing was stored (zero capacity).
+    CacheEntry* upsert(const Key& key, const Value& value) {
+        advanceTo(Clock::now());
+
+        auto it = _cache.find(key);
+        if (it != _cache.end()) {
+            _orders.splice(_orders.begin(), _orders, it->second.list_iterator);
+            it->second.value = value;
+            return &it->second;
+        }
+
+        // Check for edge case of 0 capacity
+        if (_capacity == 0) {
+            return nullptr;
+        }
+        if (_cache.size() >= _capacity) {
+            erase(_cache.find(_orders.back()));
+        }
+
+        _orders.emplace_front(key);
+        auto inserted = _cache.insert({key, CacheEntry{value, _orders.begin()}}).first;
+        return &inserted->second;
+    }
+
+    void erase(typename std::unordered_map<Key, CacheEntry>::iterator it) {
+        if (it->second.expires) {
+            _wheel.cancel(it->second.timer);
+        }
+        _orders.erase(it->second.list_iterator);
+        _cache.erase(it);
+    }
+
+    // Keys in order of usage, most recent at the front.
+    std::list<Key> _orders;
+
+    // Key to value, position in _orders and pending timer.
+    std::unordered_map<Key, CacheEntry> _cache;
+
+    Wheel _wheel;
+    size_t _capacity;
+    typename Clock::duration _tick;
+    TimePoint _epoch;
+};
+
+#endif //CPP_DATASTRUCTURES_EXPIRINGLRUCACHE_H
@@ -0,0 +1,221 @@
+#include "FlatLruCache.h"
+#include "LruCacheLinkedList.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+// Global allocation counters so the tests can assert on heap traffic and the
+// benchmark can report bytes per entry.
+static size_t g_allocations = 0;
+static size_t g_liveBytes = 0;
+static volatile long long g_sink = 0;
+
+void* operator new(size_t size) {
+    // Prefix every block with its size so operator delete can account for it.
+    auto* block = static_cast<size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if (!block) throw std::bad_alloc();
+    *block = size;
+    ++g_allocations;
+    g_liveBytes += size;
+    return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+// Kept out of line so GCC does not pair the inlined free() with operator new.
+[[gnu::noinline]] void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    auto* block = reinterpret_cast<size_t*>(static_cast<char*>(ptr) - sizeof(std::max_align_t));
+    g_liveBytes -= *block;
+    std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testMatchesLinkedListLru() {
+    // Drive both implementations with the same random trace and check that
+    // every lookup agrees; this exercises eviction and backward-shift deletes.
+    LruCacheLinkedList<int, int> reference(100);
+    FlatLruCache<int, int> flat(100);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> keyDist(0, 300);
+
+    for (int i = 0; i < 200000; ++i) {
+        const int key = keyDist(rng);
+        if (rng() % 3 == 0) {
+            reference.put(key, i);
+            flat.put(key, i);
+        } else {
+            bool refHit = true, flatHit = true;
+            int refValue = -1, flatValue = -1;
+            try { refValue = reference.get(key); } catch (const std::out_of_range&) { refHit = false; }
+            try { flatValue = flat.get(key); } catch (const std::out_of_range&) { flatHit = false; }
+            assert(refHit == flatHit);
+            assert(refValue == flatValue);
+        }
+    }
+    assert(reference.size() == flat.size());
+}
+
+void testSteadyStateDoesNotAllocate() {
+    FlatLruCache<int, int> cache(1000);
+    for (int i = 0; i < 1000; ++i) {
+        cache.put(i, i);
+    }
+    const size_t before = g_allocations;
+    for (int i = 0; i < 100000; ++i) {
+        cache.put(i, i);
+        cache.get(i);
+    }
+    assert(g_allocations == before);
+}
+
+void testCapacityOverflowThrows() {
+    bool exception_caught = false;
+    try {
+        FlatLruCache<int, int> cache(size_t{1} << 40);
+    } catch (const std::length_error&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+void testPutManyMatchesSequentialPuts() {
+    FlatLruCache<int, int> batched(50);
+    FlatLruCache<int, int> sequential(50);
+    std::vector<int> keys, values;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(static_cast<int>(rng() % 120));
+        values.push_back(i);
+    }
+    batched.putMany(keys, values);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        sequential.put(keys[i], values[i]);
+    }
+
+    std::vector<int> probe(120);
+    for (int k = 0; k < 120; ++k) {
+        probe[k] = k;
+    }
+    std::vector<std::optional<int>> a(probe.size()), b(probe.size());
+    assert(batched.getMany(probe, a) == 50);
+    assert(sequential.getMany(probe, b) == 50);
+    assert(a == b);
+}
+
+void testBatchSpanLengthsChecked() {
+    FlatLruCache<int, int> cache(4);
+    const std::vector<int> keys = {1, 2, 3};
+    std::vector<std::optional<int>> out(2);
+    bool exception_caught = false;
+    try {
+        cache.getMany(keys, out);
+    } catch (const std::invalid_argument&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+void benchmarkBatchedLookup() {
+    // Far larger than the last-level cache: ~256 MiB of entries plus the index.
+    constexpr size_t capacity = size_t{1} << 23;
+    constexpr size_t batch = 128;
+    constexpr size_t batches = 20000;
+
+    FlatLruCache<long long, long long> cache(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        cache.put(static_cast<long long>(i), static_cast<long long>(i));
+    }
+
+    std::mt19937_64 rng(9);
+    std::vector<long long> keys(batch * batches);
+    for (auto& key : keys) {
+        key = static_cast<long long>(rng() % capacity);
+    }
+    std::vector<std::optional<long long>> out(batch);
+    long long sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto key : keys) {
+        sink += cache.get(key);
+    }
+    const std::chrono::duration<double> loop = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < batches; ++b) {
+        cache.getMany(std::span<const long long>(keys).subspan(b * batch, batch), out);
+        sink += *out[0];
+    }
+    const std::chrono::duration<double> batched = std::chrono::steady_clock::now() - start;
+    g_sink = sink;
+
+    std::cout << "\nLookups on " << capacity << " entries, batches of " << batch << std::endl;
+    std::cout << "get loop\t" << keys.size() / loop.count() / 1e6 << " Mops/s" << std::endl;
+    std::cout << "getMany\t\t" << keys.size() / batched.count() / 1e6 << " Mops/s" << std::endl;
+}
+
+template <typename Cache>
+void benchmark(const std::string& label, const size_t capacity) {
+    const size_t liveBefore = g_liveBytes;
+    auto* cache = new Cache(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        cache->put(static_cast<long long>(i), static_cast<long long>(i));
+    }
+    const double bytesPerEntry = static_cast<double>(g_liveBytes - liveBefore) / capacity;
+
+    // Each iteration puts a random key from twice the capacity (so about half
+    // the puts evict) and reads it back, which is always a hit.
+    std::mt19937_64 rng(42);
+    constexpr int iterations = 2000000;
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        const long long key = static_cast<long long>(rng() % (2 * capacity));
+        cache->put(key, i);
+        sink += cache->get(key);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    delete cache;
+
+    g_sink = sink;
+
+    std::cout << label << "\t" << bytesPerEntry << "\t\t" << 2.0 * iterations / elapsed.count() / 1e6 << std::endl;
+}
+
+int main() {
+    test("Matches Linked List LRU", testMatchesLinkedListLru);
+    test("Steady State Does Not Allocate", testSteadyStateDoesNotAllocate);
+    test("Capacity Overflow Throws", testCapacityOverflowThrows);
+    test("Put Many Matches Sequential Puts", testPutManyMatchesSequentialPuts);
+    test("Batch Span Lengths Checked", testBatchSpanLengthsChecked);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    std::cout << "\n<long long, long long>, 1M entries" << std::endl;
+    std::cout << "impl\t\tbytes/entry\tMops/s" << std::endl;
+    benchmark<LruCacheLinkedList<long long, long long>>("linked-list", 1 << 20);
+    benchmark<FlatLruCache<long long, long long>>("flat\t", 1 << 20);
+
+    benchmarkBatchedLookup();
+    return 0;
+}
@@ -0,0 +1,298 @@
+#ifndef CPP_DATASTRUCTURES_FLATLRUCACHE_H
+#define CPP_DATASTRUCTURES_FLATLRUCACHE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief An LRU cache that keeps every entry in one preallocated slab.
+ *
+ * LruCacheLinkedList allocates a list node and a hash map node per key and
+ * stores the key twice. This variant allocates everything up front:
+ *  - a slab of `capacity` entries, each holding the key, the value and 32-bit
+ *    prev/next indices that form the recency list, and
+ *  - an open-addressing (linear probing) index of 32-bit slab positions,
+ *    sized to a power of two at least twice the capacity.
+ *
+ * Evicted entries are reused in place and index deletions use backward-shift,
+ * so no tombstones build up and the steady state performs no heap allocation
+ * of its own (copying a Value that allocates, such as std::string, still may).
+ *
+ * @tparam Key The key type. Must be default constructible and equality comparable.
+ * @tparam Value The cached value type. Must be default constructible.
+ * @tparam Hash The hash functor for Key.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatLruCache {
+private:
+    static constexpr uint32_t NIL = std::numeric_limits<uint32_t>::max();
+
+    // Keys resolved per prefetch round in getMany/putMany. Large enough to
+    // cover memory latency, small enough that the prefetched lines are still
+    // in L1 when they are used.
+    static constexpr size_t batchChunk = 16;
+
+    static void prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+
+    struct Entry {
+        Key key{};
+        Value value{};
+        uint32_t prev = NIL;
+        uint32_t next = NIL;
+    };
+
+public:
+    /**
+     * @brief Constructs the cache and allocates all of its storage.
+     * @param capacity Maximum number of entries.
+     * @throws std::length_error if capacity does not fit in 32-bit indices.
+     */
+    explicit FlatLruCache(const size_t capacity) : _capacity(capacity) {
+        if (capacity >= NIL / 2) {
+            throw std::length_error("FlatLruCache capacity exceeds 32-bit index range.");
+        }
+        size_t slots = 2;
+        while (slots < 2 * capacity) {
+            slots <<= 1;
+        }
+        _entries.resize(capacity);
+        _index.assign(slots, NIL);
+        _mask = slots - 1;
+    }
+
+    /**
+     * @brief Gets the value associated with a key and marks it most recently used.
+     *
+     * @param key The key to look up.
+     * @return The value associated with the key.
+     * @throws std::out_of_range if the key is not in the cache.
+     */
+    Value get(const Key& key) {
+        const uint32_t idx = _index[findSlot(key)];
+        if (idx == NIL) {
+            throw std::out_of_range("Key not found in cache.");
+        }
+        moveToFront(idx);
+        return _entries[idx].value;
+    }
+
+    /**
+     * @brief Inserts or updates a key-value pair in the cache.
+     *
+     * If the key is new and the cache is full, the least recently used entry
+     * is evicted and its slab slot is reused for the new key.
+     *
+     * @param key The key to insert or update.
+     * @param value The value associated with the key.
+     */
+    void put(const Key& key, const Value& value) {
+        size_t slot = findSlot(key);
+        uint32_t idx = _index[slot];
+
+        if (idx != NIL) {
+            _entries[idx].value = value;
+            moveToFront(idx);
+            return;
+        }
+
+        // Check for edge case of 0 capacity
+        if (_capacity == 0) {
+            return;
+        }
+
+        if (_size < _capacity) {
+            idx = static_cast<uint32_t>(_size++);
+        } else {
+            // Evict the least recently used entry and reuse its slot.
+            idx = _tail;
+            unlink(idx);
+            eraseSlot(findSlot(_entries[idx].key));
+            // The backward shift may have moved the empty slot we found earlier.
+            slot = findSlot(key);
+        }
+
+        _entries[idx].key = key;
+        _entries[idx].value = value;
+        _index[slot] = idx;
+        pushFront(idx);
+    }
+
+    /**
+     * @brief Looks up a batch of keys, reporting misses as std::nullopt.
+     *
+     * Keys are processed in chunks: first every key is hashed and its index
+     * slot prefetched, then the entry each slot points at is prefetched, then
+     * that entry's recency-list neighbours, and only then are the keys
+     * resolved. On a cache much larger
+     * than the last-level cache this overlaps the memory misses of a whole
+     * chunk instead of paying them one after another. Hits are marked most
+     * recently used in key order.
+     *
+     * @param keys The keys to look up.
+     * @param out Receives the value or std::nullopt for each key; must be at
+     *            least as long as keys.
+     * @return The number of hits.
+     */
+    size_t getMany(std::span<const Key> keys, std::span<std::optional<Value>> out) {
+        if (out.size() < keys.size()) {
+            throw std::invalid_argument("getMany output span is shorter than the key span.");
+        }
+        size_t hits = 0;
+        size_t slots[batchChunk];
+        for (size_t base = 0; base < keys.size(); base += batchChunk) {
+            const size_t n = std::min(batchChunk, keys.size() - base);
+            for (size_t i = 0; i < n; ++i) {
+                slots[i] = homeSlot(keys[base + i]);
+                prefetch(&_index[slots[i]]);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                const uint32_t candidate = _index[slots[i]];
+                if (candidate != NIL) {
+                    prefetch(&_entries[candidate]);
+                }
+            }
+            // Moving a hit to the front rewrites its list neighbours too.
+            for (size_t i = 0; i < n; ++i) {
+                const uint32_t candidate = _index[slots[i]];
+                if (candidate != NIL) {
+                    const Entry& e = _entries[candidate];
+                    if (e.prev != NIL) prefetch(&_entries[e.prev]);
+                    if (e.next != NIL) prefetch(&_entries[e.next]);
+                }
+            }
+            for (size_t i = 0; i < n; ++i) {
+                const uint32_t idx = _index[probeFrom(slots[i], keys[base + i])];
+                if (idx == NIL) {
+                    out[base + i].reset();
+                    continue;
+                }
+                moveToFront(idx);
+                out[base + i] = _entries[idx].value;
+                ++hits;
+            }
+        }
+        return hits;
+    }
+
+    /**
+     * @brief Inserts or updates a batch of key-value pairs, in order.
+     *
+     * Index slots for a chunk of keys are prefetched before the puts are
+     * applied. The result is the same as calling put for each pair in turn.
+     *
+     * @param keys The keys to insert or update.
+     * @param values The value for each key; must be as long as keys.
+     */
+    void putMany(std::span<const Key> keys, std::span<const Value> values) {
+        if (values.size() != keys.size()) {
+            throw std::invalid_argument("putMany key and value spans differ in length.");
+        }
+        for (size_t base = 0; base < keys.size(); base += batchChunk) {
+            const size_t n = std::min(batchChunk, keys.size() - base);
+            for (size_t i = 0; i < n; ++i) {
+                prefetch(&_index[homeSlot(keys[base + i])]);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                put(keys[base + i], values[base + i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the number of entries currently held by the cache.
+     */
+    size_t size() const { return _size; }
+
+    /**
+     * @brief Returns the maximum number of entries the cache will hold.
+     */
+    size_t capacity() const { return _capacity; }
+
+private:
+    size_t homeSlot(const Key& key) const {
+        // Fibonacci hashing spreads identity hashes of integers across the table.
+        return static_cast<size_t>((static_cast<uint64_t>(_hasher(key)) * 0x9E3779B97F4A7C15ULL) >> 32) & _mask;
+    }
+
+    // Returns the slot holding key, or the empty slot where it would be inserted.
+    size_t findSlot(const Key& key) const {
+        return probeFrom(homeSlot(key), key);
+    }
+
+    size_t probeFrom(size_t pos, const Key& key) const {
+        while (_index[pos] != NIL && !(_entries[_index[pos]].key == key)) {
+            pos = (pos + 1) & _mask;
+        }
+        return pos;
+    }
+
+    // Backward-shift deletion: pull later members of the probe run into the hole
+    // so lookups never need tombstones.
+    void eraseSlot(size_t hole) {
+        size_t pos = hole;
+        while (true) {
+            pos = (pos + 1) & _mask;
+            if (_index[pos] == NIL) {
+                break;
+            }
+            const size_t home = homeSlot(_entries[_index[pos]].key);
+            // Distance from home to pos versus from home to hole, modulo table size.
+            if (((pos - home) & _mask) >= ((pos - hole) & _mask)) {
+                _index[hole] = _index[pos];
+                hole = pos;
+            }
+        }
+        _index[hole] = NIL;
+    }
+
+    void unlink(const uint32_t idx) {
+        Entry& e = _entries[idx];
+        if (e.prev != NIL) _entries[e.prev].next = e.next; else _head = e.next;
+        if (e.next != NIL) _entries[e.next].prev = e.prev; else _tail = e.prev;
+        e.prev = e.next = NIL;
+    }
+
+    void pushFront(const uint32_t idx) {
+        Entry& e = _entries[idx];
+        e.prev = NIL;
+        e.next = _head;
+        if (_head != NIL) _entries[_head].prev = idx;
+        _head = idx;
+        if (_tail == NIL) _tail = idx;
+    }
+
+    void moveToFront(const uint32_t idx) {
+        if (idx == _head) {
+            return;
+        }
+        unlink(idx);
+        pushFront(idx);
+    }
+
+    // Slab of entries; positions [0, _size) are in use.
+    std::vector<Entry> _entries;
+
+    // Open-addressing index mapping hashed keys to slab positions.
+    std::vector<uint32_t> _index;
+
+    size_t _mask = 0;
+    size_t _size = 0;
+    size_t _capacity;
+    uint32_t _head = NIL;
+    uint32_t _tail = NIL;
+    Hash _hasher;
+};
+
+#endif //CPP_DATASTRUCTURES_FLATLRUCACHE_H
@@ -0,0 +1,119 @@
+#ifndef CPP_DATASTRUCTURES_FREQUENCYSKETCH_H
+#define CPP_DATASTRUCTURES_FREQUENCYSKETCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief A count-min sketch of 4-bit counters with periodic aging.
+ *
+ * Estimates how often each key has been seen recently using a fixed amount of
+ * memory: `depth` rows of `width` counters, packed 16 to a 64-bit word. A key
+ * maps to one counter per row and its estimate is the minimum of those
+ * counters, which can overestimate but never underestimates.
+ *
+ * Counters saturate at 15. After `10 * width` increments every counter is
+ * halved, so the sketch forgets old popularity and follows shifts in the
+ * workload.
+ *
+ * @tparam Key The key type. Must be hashable by Hash.
+ * @tparam Hash The hash functor for Key.
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class FrequencySketch {
+public:
+    static constexpr size_t depth = 4;
+
+    /**
+     * @brief Constructs a sketch.
+     * @param counters Counters per row, rounded up to a power of two (minimum 16).
+     *                 Total memory is depth * counters / 2 bytes.
+     */
+    explicit FrequencySketch(const size_t counters) {
+        _width = 16;
+        while (_width < counters) {
+            _width <<= 1;
+        }
+        _table.assign(depth * _width / countersPerWord, 0);
+        _sampleSize = 10 * _width;
+    }
+
+    /**
+     * @brief Records one occurrence of key.
+     */
+    void increment(const Key& key) {
+        const uint64_t h = static_cast<uint64_t>(_hasher(key));
+        bool added = false;
+        for (size_t row = 0; row < depth; ++row) {
+            added |= incrementAt(row, indexFor(h, row));
+        }
+        if (added && ++_additions >= _sampleSize) {
+            reset();
+        }
+    }
+
+    /**
+     * @brief Returns the estimated recent frequency of key, in [0, 15].
+     */
+    uint32_t estimate(const Key& key) const {
+        const uint64_t h = static_cast<uint64_t>(_hasher(key));
+        uint32_t freq = maxCount;
+        for (size_t row = 0; row < depth; ++row) {
+            freq = std::min(freq, counterAt(row, indexFor(h, row)));
+        }
+        return freq;
+    }
+
+    /**
+     * @brief Returns the memory used by the counters, in bytes.
+     */
+    size_t memoryBytes() const { return _table.size() * sizeof(uint64_t); }
+
+private:
+    static constexpr size_t countersPerWord = 16;
+    static constexpr uint32_t maxCount = 15;
+
+    size_t indexFor(uint64_t h, const size_t row) const {
+        // Derive an independent hash per row from a single key hash.
+        h += (row + 1) * 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h) & (_width - 1);
+    }
+
+    uint32_t counterAt(const size_t row, const size_t col) const {
+        const size_t bit = row * _width + col;
+        return static_cast<uint32_t>((_table[bit / countersPerWord] >> ((bit % countersPerWord) * 4)) & 0xF);
+    }
+
+    bool incrementAt(const size_t row, const size_t col) {
+        const size_t bit = row * _width + col;
+        const unsigned shift = (bit % countersPerWord) * 4;
+        uint64_t& word = _table[bit / countersPerWord];
+        if (((word >> shift) & 0xF) == maxCount) {
+            return false;
+        }
+        word += uint64_t{1} << shift;
+        return true;
+    }
+
+    // Halves every counter at once: shift each word right and mask off the
+    // bit that leaked in from the neighbouring counter.
+    void reset() {
+        for (auto& word : _table) {
+            word = (word >> 1) & 0x7777777777777777ULL;
+        }
+        _additions /= 2;
+    }
+
+    std::vector<uint64_t> _table;
+    size_t _width = 0;
+    size_t _sampleSize = 0;
+    size_t _additions = 0;
+    Hash _hasher;
+};
+
+#endif //CPP_DATASTRUCTURES_FREQUENCYSKETCH_H
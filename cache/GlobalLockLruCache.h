@@ -0,0 +1,34 @@
+#ifndef CPP_DATASTRUCTURES_GLOBALLOCKLRUCACHE_H
+#define CPP_DATASTRUCTURES_GLOBALLOCKLRUCACHE_H
+
+#include "LruCacheLinkedList.h"
+
+#include <mutex>
+
+/**
+ * @brief LruCacheLinkedList behind a single mutex.
+ *
+ * This is the straightforward way to share the LRU between threads and serves
+ * as the baseline in the concurrent cache benchmarks.
+ */
+template <typename Key, typename Value>
+class GlobalLockLruCache {
+public:
+    explicit GlobalLockLruCache(const size_t capacity) : _lru(capacity) {}
+
+    Value get(const Key& key) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        return _lru.get(key);
+    }
+
+    void put(const Key& key, const Value& value) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _lru.put(key, value);
+    }
+
+private:
+    std::mutex _mtx;
+    LruCacheLinkedList<Key, Value> _lru;
+};
+
+#endif //CPP_DATASTRUCTURES_GLOBALLOCKLRUCACHE_H
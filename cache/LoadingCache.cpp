@@ -0,0 +1,201 @@
+#include "LoadingCache.h"
+#include "GlobalLockLruCache.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+// A monotonic clock the tests advance by hand.
+struct ManualClock {
+    using duration = std::chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static inline std::atomic<time_point> current{};
+    static time_point now() { return current.load(); }
+    static void advance(const duration d) { current = current.load() + d; }
+};
+
+using namespace std::chrono_literals;
+
+void testLoadsOnMissAndCaches() {
+    std::atomic<int> calls{0};
+    LoadingCache<int, std::string> cache(10, [&calls](const int& key) {
+        ++calls;
+        return "value-" + std::to_string(key);
+    });
+    assert(cache.get(1) == "value-1");
+    assert(cache.get(1) == "value-1");
+    assert(calls == 1);
+    assert(cache.loadCount() == 1);
+}
+
+void testConcurrentMissesShareOneLoad() {
+    std::atomic<int> calls{0};
+    LoadingCache<int, int> cache(10, [&calls](const int& key) {
+        ++calls;
+        std::this_thread::sleep_for(50ms);
+        return key * 10;
+    });
+
+    std::vector<std::thread> threads;
+    std::atomic<int> correct{0};
+    for (int t = 0; t < 32; ++t) {
+        threads.emplace_back([&cache, &correct] {
+            if (cache.get(7) == 70) ++correct;
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    assert(calls == 1);
+    assert(correct == 32);
+}
+
+void testLoaderExceptionReachesAllWaitersAndIsNotCached() {
+    std::atomic<int> calls{0};
+    LoadingCache<int, int> cache(10, [&calls](const int&) -> int {
+        if (++calls == 1) {
+            std::this_thread::sleep_for(30ms);
+            throw std::runtime_error("backend down");
+        }
+        return 5;
+    });
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&cache, &failures] {
+            try {
+                cache.get(1);
+            } catch (const std::runtime_error&) {
+                ++failures;
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    assert(failures == 8);
+    assert(cache.get(1) == 5);
+    assert(calls == 2);
+}
+
+void testTtlReloads() {
+    std::atomic<int> version{0};
+    LoadingCache<int, int, ManualClock> cache(10, [&version](const int&) { return ++version; },
+                                              {.ttl = 100ms});
+    assert(cache.get(1) == 1);
+    ManualClock::advance(99ms);
+    assert(cache.get(1) == 1);
+    ManualClock::advance(1ms);
+    assert(cache.get(1) == 2);
+}
+
+void testRefreshAheadServesOldValueWhileReloading() {
+    std::atomic<int> version{0};
+    std::atomic<bool> release{false};
+    LoadingCache<int, int, ManualClock> cache(10, [&version, &release](const int&) {
+        const int v = ++version;
+        if (v > 1) {
+            while (!release) std::this_thread::yield();
+        }
+        return v;
+    }, {.ttl = 100ms, .refreshAhead = 20ms});
+
+    assert(cache.get(1) == 1);
+    ManualClock::advance(85ms);
+    // Inside the refresh window: the old value comes back immediately.
+    assert(cache.get(1) == 1);
+    assert(cache.get(1) == 1);
+    assert(cache.loadCount() == 2);
+
+    release = true;
+    while (true) {
+        if (cache.get(1) == 2) break;
+        std::this_thread::yield();
+    }
+    // Fresh again: no further refresh was started.
+    assert(cache.loadCount() == 2);
+}
+
+void testInvalidate() {
+    std::atomic<int> version{0};
+    LoadingCache<int, int> cache(10, [&version](const int&) { return ++version; });
+    assert(cache.get(1) == 1);
+    cache.invalidate(1);
+    assert(cache.get(1) == 2);
+}
+
+// Simulates a hot key being evicted while 32 threads request it, with and
+// without miss coalescing.
+void benchmarkThunderingHerd() {
+    constexpr int threads = 32;
+    constexpr auto loadTime = 20ms;
+    std::atomic<int> loads{0};
+    auto loader = [&loads, loadTime](const int& key) {
+        ++loads;
+        std::this_thread::sleep_for(loadTime);
+        return key;
+    };
+
+    GlobalLockLruCache<int, int> plain(16);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&plain, &loader] {
+            try {
+                plain.get(1);
+            } catch (const std::out_of_range&) {
+                plain.put(1, loader(1));
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    const int plainLoads = loads.exchange(0);
+
+    LoadingCache<int, int> coalescing(16, loader);
+    workers.clear();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&coalescing] { coalescing.get(1); });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    std::cout << "\nLoader calls for one hot miss from " << threads << " threads" << std::endl;
+    std::cout << "get-then-put\t" << plainLoads << std::endl;
+    std::cout << "LoadingCache\t" << loads.load() << std::endl;
+}
+
+int main() {
+    test("Loads On Miss And Caches", testLoadsOnMissAndCaches);
+    test("Concurrent Misses Share One Load", testConcurrentMissesShareOneLoad);
+    test("Loader Exception Reaches All Waiters", testLoaderExceptionReachesAllWaitersAndIsNotCached);
+    test("TTL Reloads", testTtlReloads);
+    test("Refresh Ahead Serves Old Value While Reloading", testRefreshAheadServesOldValueWhileReloading);
+    test("Invalidate", testInvalidate);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkThunderingHerd();
+    return 0;
+}
@@ -0,0 +1,201 @@
+#ifndef CPP_DATASTRUCTURES_LOADINGCACHE_H
+#define CPP_DATASTRUCTURES_LOADINGCACHE_H
+
+#include "LruCacheLinkedList.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief A thread-safe read-through LRU cache that coalesces concurrent loads.
+ *
+ * get never misses from the caller's point of view: on a miss the cache calls
+ * the loader. Only one load per key is ever in flight. Threads that miss on a
+ * key already being loaded wait on the same std::shared_future instead of
+ * recomputing the value, which removes the thundering herd after a hot key is
+ * evicted. The lock is not held while the loader runs.
+ *
+ * Entries can optionally expire after a TTL. With refresh-ahead enabled, a hit
+ * on an entry that is close to expiry starts one background reload while still
+ * returning the current value, so hot keys are refreshed before they expire
+ * and callers never block on them.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The cached value type.
+ * @tparam Clock A monotonic clock with a static now().
+ */
+template <typename Key, typename Value, typename Clock = std::chrono::steady_clock>
+class LoadingCache {
+public:
+    using Loader = std::function<Value(const Key&)>;
+    using Duration = typename Clock::duration;
+
+    struct Options {
+        // Entries older than this are reloaded; zero means they never expire.
+        Duration ttl = Duration::zero();
+
+        // A hit within this window before expiry triggers a background reload;
+        // zero disables refresh-ahead. Only meaningful with a ttl.
+        Duration refreshAhead = Duration::zero();
+    };
+
+private:
+    struct CacheEntry {
+        Value value;
+        typename Clock::time_point loadedAt;
+    };
+
+public:
+    /**
+     * @brief Constructs the cache.
+     * @param capacity Maximum number of entries.
+     * @param loader Computes the value for a key; may throw.
+     * @param options Expiry and refresh-ahead settings.
+     */
+    LoadingCache(const size_t capacity, Loader loader, Options options = {})
+        : _lru(capacity), _loader(std::move(loader)), _options(options) {}
+
+    /**
+     * @brief Waits for background refreshes to finish before destruction.
+     */
+    ~LoadingCache() {
+        std::unique_lock<std::mutex> lock(_mtx);
+        _refreshDone.wait(lock, [this] { return _pendingRefreshes == 0; });
+    }
+
+    LoadingCache(const LoadingCache&) = delete;
+    LoadingCache& operator=(const LoadingCache&) = delete;
+
+    /**
+     * @brief Returns the value for key, loading it if absent or expired.
+     *
+     * @param key The key to look up.
+     * @return The cached or freshly loaded value.
+     * @throws Whatever the loader throws; failed loads are not cached and every
+     *         caller waiting on that load sees the same exception.
+     */
+    Value get(const Key& key) {
+        std::unique_lock<std::mutex> lock(_mtx);
+        const auto now = Clock::now();
+
+        if (_lru.contains(key)) {
+            CacheEntry entry = _lru.get(key);
+            const Duration age = now - entry.loadedAt;
+            if (!expires() || age < _options.ttl) {
+                if (shouldRefresh(age) && _inFlight.find(key) == _inFlight.end()) {
+                    startRefresh(key);
+                }
+                return entry.value;
+            }
+        }
+
+        // Miss or expired: join a load already in flight, or start one.
+        auto inFlight = _inFlight.find(key);
+        if (inFlight != _inFlight.end()) {
+            std::shared_future<Value> pending = inFlight->second;
+            lock.unlock();
+            return pending.get();
+        }
+
+        std::promise<Value> promise;
+        _inFlight.emplace(key, promise.get_future().share());
+        ++_loads;
+        lock.unlock();
+
+        try {
+            Value value = _loader(key);
+            lock.lock();
+            _lru.put(key, CacheEntry{value, Clock::now()});
+            _inFlight.erase(key);
+            lock.unlock();
+            promise.set_value(value);
+            return value;
+        } catch (...) {
+            if (!lock.owns_lock()) {
+                lock.lock();
+            }
+            _inFlight.erase(key);
+            lock.unlock();
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    /**
+     * @brief Drops a key so that the next get reloads it.
+     *
+     * A load already in flight for the key is not cancelled and will store
+     * its result when it completes.
+     */
+    void invalidate(const Key& key) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _lru.erase(key);
+    }
+
+    /**
+     * @brief Returns how many times the loader has been called, including refreshes.
+     */
+    size_t loadCount() const {
+        std::lock_guard<std::mutex> lock(_mtx);
+        return _loads;
+    }
+
+private:
+    bool expires() const { return _options.ttl > Duration::zero(); }
+
+    bool shouldRefresh(const Duration age) const {
+        return expires() && _options.refreshAhead > Duration::zero() &&
+               age >= _options.ttl - _options.refreshAhead;
+    }
+
+    // Reloads key on a background thread. Callers that miss on the key while
+    // the refresh runs wait for it like any other in-flight load. Caller must
+    // hold _mtx.
+    void startRefresh(const Key& key) {
+        auto promise = std::make_shared<std::promise<Value>>();
+        _inFlight.emplace(key, promise->get_future().share());
+        ++_loads;
+        ++_pendingRefreshes;
+
+        std::thread([this, key, promise] {
+            try {
+                Value value = _loader(key);
+                std::lock_guard<std::mutex> lock(_mtx);
+                _lru.put(key, CacheEntry{value, Clock::now()});
+                _inFlight.erase(key);
+                promise->set_value(std::move(value));
+            } catch (...) {
+                // Keep serving the old value until it expires.
+                std::lock_guard<std::mutex> lock(_mtx);
+                _inFlight.erase(key);
+                promise->set_exception(std::current_exception());
+            }
+            std::lock_guard<std::mutex> lock(_mtx);
+            --_pendingRefreshes;
+            _refreshDone.notify_all();
+        }).detach();
+    }
+
+    LruCacheLinkedList<Key, CacheEntry> _lru;
+
+    // One shared future per key whose load is currently running.
+    std::unordered_map<Key, std::shared_future<Value>> _inFlight;
+
+    Loader _loader;
+    Options _options;
+    mutable std::mutex _mtx;
+    std::condition_variable _refreshDone;
+    size_t _pendingRefreshes = 0;
+    size_t _loads = 0;
+};
+
+#endif //CPP_DATASTRUCTURES_LOADINGCACHE_H
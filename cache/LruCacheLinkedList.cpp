@@ -1,7 +1,12 @@
 #include "LruCacheLinkedList.h"
+#include "FlatLruCache.h"
+#include "ClockCache.h"
+#include "ArcCache.h"
 #include <iostream>
 #include <cassert>
 #include <functional>
+#include <optional>
+#include <vector>
 
 void test(const std::string& name, std::function<void()> func) {
     std::cout << "Running test: " << name << "..." << std::endl;
@@ -14,16 +19,18 @@ void test(const std::string& name, std::function<void()> func) {
     }
 }
 
+template <typename Cache>
 void testBasicPutAndGet() {
-    LruCacheLinkedList<int, std::string> cache(2);
+    Cache cache(2);
     cache.put(1, "one");
     cache.put(2, "two");
     assert(cache.get(1) == "one");
     assert(cache.get(2) == "two");
 }
 
+template <typename Cache>
 void testLruEviction() {
-    LruCacheLinkedList<int, std::string> cache(2);
+    Cache cache(2);
     cache.put(1, "one");
     cache.put(2, "two");
     cache.put(3, "three");
@@ -41,8 +48,9 @@ void testLruEviction() {
     assert(cache.get(3) == "three");
 }
 
+template <typename Cache>
 void testUpdateExistingItem() {
-    LruCacheLinkedList<int, std::string> cache(2);
+    Cache cache(2);
     cache.put(1, "one");
     cache.put(2, "two");
     cache.put(1, "uno");
@@ -59,8 +67,9 @@ void testUpdateExistingItem() {
     assert(cache.get(1) == "uno");
 }
 
+template <typename Cache>
 void testAccessUpdatesRecency() {
-    LruCacheLinkedList<int, std::string> cache(3);
+    Cache cache(3);
     cache.put(1, "one");
     cache.put(2, "two");
     cache.put(3, "three");
@@ -80,8 +89,9 @@ void testAccessUpdatesRecency() {
     assert(cache.get(4) == "four");
 }
 
+template <typename Cache>
 void testEmptyCache() {
-    LruCacheLinkedList<int, std::string> cache(1);
+    Cache cache(1);
     bool exception_caught = false;
     try {
         cache.get(10);
@@ -91,8 +101,9 @@ void testEmptyCache() {
     assert(exception_caught);
 }
 
+template <typename Cache>
 void testZeroCapacity() {
-    LruCacheLinkedList<int, std::string> cache(0);
+    Cache cache(0);
     cache.put(1, "one");
     bool exception_caught = false;
     try {
@@ -103,13 +114,98 @@ void testZeroCapacity() {
     assert(exception_caught);
 }
 
+template <typename Cache>
+void testGetMany() {
+    Cache cache(3);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+
+    const std::vector<int> keys = {3, 9, 1};
+    std::vector<std::optional<std::string>> out(keys.size());
+    assert(cache.getMany(keys, out) == 2);
+    assert(out[0] == "three");
+    assert(!out[1].has_value());
+    assert(out[2] == "one");
+
+    // The batch touched 3 then 1, so 2 is now least recently used.
+    cache.put(4, "four");
+    bool exception_caught = false;
+    try {
+        cache.get(2);
+    } catch (const std::out_of_range&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+template <typename Cache>
+void testPutMany() {
+    Cache cache(3);
+    cache.put(1, "one");
+    const std::vector<int> keys = {2, 1, 3, 4};
+    const std::vector<std::string> values = {"two", "uno", "three", "four"};
+    cache.putMany(keys, values);
+
+    // As four puts in order: 1 is updated, and 4 evicts 2, the oldest.
+    assert(cache.size() == 3);
+    assert(cache.get(1) == "uno");
+    assert(cache.get(4) == "four");
+    std::vector<std::optional<std::string>> out(1);
+    assert(cache.getMany(std::vector<int>{2}, out) == 0);
+
+    bool exception_caught = false;
+    try {
+        cache.putMany(keys, std::vector<std::string>(2));
+    } catch (const std::invalid_argument&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+void testEvictLeastRecent() {
+    LruCacheLinkedList<int, std::string> cache(3);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+    cache.get(1);
+
+    assert(cache.leastRecentKey() == 2);
+    auto victim = cache.evictLeastRecent();
+    assert(victim.first == 2 && victim.second == "two");
+    assert(!cache.contains(2));
+    assert(cache.contains(1));
+    assert(cache.size() == 2);
+}
+
+template <typename Cache>
+void runAll(const std::string& label) {
+    std::cout << "--- " << label << " ---" << std::endl;
+    test("Basic Put and Get", testBasicPutAndGet<Cache>);
+    test("LRU Eviction", testLruEviction<Cache>);
+    test("Update Existing Item", testUpdateExistingItem<Cache>);
+    test("Access Updates Recency", testAccessUpdatesRecency<Cache>);
+    test("Empty Cache", testEmptyCache<Cache>);
+    test("Zero Capacity", testZeroCapacity<Cache>);
+}
+
 int main() {
-    test("Basic Put and Get", testBasicPutAndGet);
-    test("LRU Eviction", testLruEviction);
-    test("Update Existing Item", testUpdateExistingItem);
-    test("Access Updates Recency", testAccessUpdatesRecency);
-    test("Empty Cache", testEmptyCache);
-    test("Zero Capacity", testZeroCapacity);
+    runAll<LruCacheLinkedList<int, std::string>>("LruCacheLinkedList");
+    runAll<FlatLruCache<int, std::string>>("FlatLruCache");
+    // CLOCK only approximates LRU, but on these small traces the second-chance
+    // sweep evicts exactly the entries LRU would.
+    runAll<ClockCache<int, std::string>>("ClockCache");
+    // With no ghost history yet, ARC also evicts in LRU order here.
+    runAll<ArcCache<int, std::string>>("ArcCache");
+
+    std::cout << "--- Batch lookups ---" << std::endl;
+    test("Get Many (LruCacheLinkedList)", testGetMany<LruCacheLinkedList<int, std::string>>);
+    test("Get Many (FlatLruCache)", testGetMany<FlatLruCache<int, std::string>>);
+    test("Put Many (LruCacheLinkedList)", testPutMany<LruCacheLinkedList<int, std::string>>);
+    test("Put Many (FlatLruCache)", testPutMany<FlatLruCache<int, std::string>>);
+
+    std::cout << "--- LruCacheLinkedList only ---" << std::endl;
+    test("Evict Least Recent", testEvictLeastRecent);
     std::cout << "\nAll tests passed!" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -1,8 +1,22 @@
+#ifndef CPP_DATASTRUCTURES_LRUCACHELINKEDLIST_H
+#define CPP_DATASTRUCTURES_LRUCACHELINKEDLIST_H
+
+#include "CacheStats.h"
+
 #include <list>
+#include <optional>
+#include <span>
 #include <unordered_map>
 #include <stdexcept>
+#include <utility>
 
-template <typename Key, typename Value>
+/**
+ * @tparam Key The key type.
+ * @tparam Value The cached value type.
+ * @tparam Stats cache_stats::CacheStats to record hits, misses, evictions and
+ *         latencies, or the default cache_stats::NoStats for no overhead.
+ */
+template <typename Key, typename Value, typename Stats = cache_stats::NoStats>
 class LruCacheLinkedList {
 private:
     // A struct to hold the cached value and the list iterator.
@@ -27,13 +41,17 @@ public:
      * @throws std::out_of_range if the key is not in the cache.
      */
     Value get(const Key& key) {
+        [[maybe_unused]] const auto timer = _stats.timeGet();
+
         // Find the key in the hash map.
         auto it = _cache.find(key);
 
         // If the key is not found, throw an exception.
         if (it == _cache.end()) {
+            _stats.recordMiss();
             throw std::out_of_range("Key not found in cache.");
         }
+        _stats.recordHit();
 
         // Access the CacheEntry struct for the list iterator.
         // The list iterator points to the key's current position in _orders.
@@ -58,11 +76,15 @@ public:
      * @param value The value associated with the key.
      */
     void put(const Key& key, const Value& value) {
+        [[maybe_unused]] const auto timer = _stats.timePut();
+
         // Find the key in the hash map.
         auto it = _cache.find(key);
 
         // If the key already exists, update its value and position.
         if (it != _cache.end()) {
+            _stats.recordUpdate();
+
             // Move the existing key to the front of the list.
             _orders.splice(_orders.begin(), _orders, it->second.list_iterator);
 
@@ -78,13 +100,15 @@ public:
             if (_orders.empty()) {
                 return;
             }
-            // 1. Get the key from the back of the linked list.
-            Key lru_key = _orders.back();
+            // 1. Find the entry for the key at the back of the linked list.
+            auto lru_it = _cache.find(_orders.back());
+            _stats.recordEviction(lru_it->second.value);
             // 2. Erase the key from the hash map.
-            _cache.erase(lru_key);
+            _cache.erase(lru_it);
             // 3. Remove the key from the linked list.
             _orders.pop_back();
         }
+        _stats.recordInsert();
 
         // Insert the new key at the front of the linked list (most recently used).
         _orders.emplace_front(key);
@@ -95,6 +119,157 @@ public:
         _cache.insert({key, {value, _orders.begin()}});
     }
 
+    /**
+     * @brief Looks up a batch of keys, reporting misses as std::nullopt.
+     *
+     * Equivalent to calling get for each key in order, without an exception
+     * per miss. Unlike FlatLruCache::getMany this cannot prefetch ahead of the
+     * lookups: std::unordered_map allocates every entry as a separate node, so
+     * prefetching a key's bucket would only bring in a pointer, and following
+     * it to the entry is the very miss a prefetch is meant to hide.
+     *
+     * @param keys The keys to look up.
+     * @param out Receives the value or std::nullopt for each key; must be at
+     *            least as long as keys.
+     * @return The number of hits.
+     */
+    size_t getMany(std::span<const Key> keys, std::span<std::optional<Value>> out) {
+        if (out.size() < keys.size()) {
+            throw std::invalid_argument("getMany output span is shorter than the key span.");
+        }
+        size_t hits = 0;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            auto it = _cache.find(keys[i]);
+            if (it == _cache.end()) {
+                _stats.recordMiss();
+                out[i].reset();
+                continue;
+            }
+            _stats.recordHit();
+            _orders.splice(_orders.begin(), _orders, it->second.list_iterator);
+            out[i] = it->second.value;
+            ++hits;
+        }
+        return hits;
+    }
+
+    /**
+     * @brief Inserts or updates a batch of key-value pairs, in order.
+     *
+     * The result is the same as calling put for each pair in turn. For the
+     * reason given at getMany there is no prefetching; the batch form exists
+     * so callers can use either cache through the same interface.
+     *
+     * @param keys The keys to insert or update.
+     * @param values The value for each key; must be as long as keys.
+     */
+    void putMany(std::span<const Key> keys, std::span<const Value> values) {
+        if (values.size() != keys.size()) {
+            throw std::invalid_argument("putMany key and value spans differ in length.");
+        }
+        for (size_t i = 0; i < keys.size(); ++i) {
+            put(keys[i], values[i]);
+        }
+    }
+
+    /**
+     * @brief Checks whether a key is cached without changing its recency.
+     * @param key The key to look up.
+     * @return true if the key is in the cache.
+     */
+    bool contains(const Key& key) const { return _cache.find(key) != _cache.end(); }
+
+    /**
+     * @brief Removes a key from the cache.
+     * @param key The key to remove.
+     * @return true if the key was present.
+     */
+    bool erase(const Key& key) {
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            return false;
+        }
+        _orders.erase(it->second.list_iterator);
+        _cache.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Returns the least recently used key without evicting it.
+     * @throws std::out_of_range if the cache is empty.
+     */
+    const Key& leastRecentKey() const {
+        if (_orders.empty()) {
+            throw std::out_of_range("Cache is empty.");
+        }
+        return _orders.back();
+    }
+
+    /**
+     * @brief Removes and returns the least recently used entry.
+     *
+     * Lets a wrapping policy decide what happens to a victim (for example,
+     * promote it to another segment) instead of dropping it inside put.
+     *
+     * @return The evicted key and its value.
+     * @throws std::out_of_range if the cache is empty.
+     */
+    std::pair<Key, Value> evictLeastRecent() {
+        if (_orders.empty()) {
+            throw std::out_of_range("Cache is empty.");
+        }
+        auto it = _cache.find(_orders.back());
+        _stats.recordEviction(it->second.value);
+        std::pair<Key, Value> victim{it->first, std::move(it->second.value)};
+        _cache.erase(it);
+        _orders.pop_back();
+        return victim;
+    }
+
+    /**
+     * @brief Visits every entry from most to least recently used without
+     * changing recency.
+     * @param visit Called as visit(key, value) for each entry.
+     */
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (const Key& key : _orders) {
+            visit(key, _cache.find(key)->second.value);
+        }
+    }
+
+    /**
+     * @brief Visits every entry from least to most recently used without
+     * changing recency, the order in which put would rebuild the cache.
+     * @param visit Called as visit(key, value) for each entry.
+     */
+    template <typename Visitor>
+    void forEachLeastRecentFirst(Visitor&& visit) const {
+        for (auto it = _orders.rbegin(); it != _orders.rend(); ++it) {
+            visit(*it, _cache.find(*it)->second.value);
+        }
+    }
+
+    /**
+     * @brief Pre-sizes the hash map for the given number of entries.
+     */
+    void reserve(const size_t entries) { _cache.reserve(entries); }
+
+    /**
+     * @brief Returns the number of entries currently held by the cache.
+     */
+    size_t size() const { return _cache.size(); }
+
+    /**
+     * @brief Returns the maximum number of entries the cache will hold.
+     */
+    size_t capacity() const { return _capacity; }
+
+    /**
+     * @brief Returns the aggregated statistics; all zero when Stats is NoStats.
+     */
+    cache_stats::Snapshot stats() const { return _stats.snapshot(); }
+
 private:
     // A doubly-linked list to store the keys in order of usage.
     // The most recently used key is at the front, and the least recently used is at the back.
@@ -104,4 +279,8 @@ private:
     // to their location in the linked list for O(1) lookup and removal.
     std::unordered_map<Key, CacheEntry> _cache;
     size_t _capacity;
+
+    [[no_unique_address]] Stats _stats;
 };
+
+#endif //CPP_DATASTRUCTURES_LRUCACHELINKEDLIST_H
@@ -0,0 +1,135 @@
+#include "LruCacheSnapshot.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+struct Point {
+    int x;
+    double y;
+};
+
+void testRoundTripPreservesRecency() {
+    LruCacheLinkedList<int, Point> cache(4);
+    cache.put(1, {1, 1.5});
+    cache.put(2, {2, 2.5});
+    cache.put(3, {3, 3.5});
+    cache.get(1); // recency, most recent first: 1, 3, 2
+
+    const std::string path = tempPath("lru_snapshot_roundtrip.bin");
+    lru_snapshot::save(cache, path);
+    auto restored = lru_snapshot::load<int, Point>(path, 4);
+    std::filesystem::remove(path);
+
+    assert(restored.size() == 3);
+    assert(restored.get(3).y == 3.5);
+    // get(3) above makes the order 3, 1, 2; filling up evicts 2 and then 1.
+    restored.put(4, {4, 4.5});
+    restored.put(5, {5, 5.5});
+    assert(!restored.contains(2));
+    assert(restored.contains(1));
+    restored.put(6, {6, 6.5});
+    assert(!restored.contains(1));
+    assert(restored.contains(3));
+}
+
+void testSmallerCapacityKeepsMostRecent() {
+    LruCacheLinkedList<int, int> cache(10);
+    for (int i = 0; i < 10; ++i) {
+        cache.put(i, i * i);
+    }
+    const std::string path = tempPath("lru_snapshot_truncate.bin");
+    lru_snapshot::save(cache, path);
+    auto restored = lru_snapshot::load<int, int>(path, 3);
+    std::filesystem::remove(path);
+
+    assert(restored.size() == 3);
+    assert(restored.leastRecentKey() == 7);
+    assert(restored.get(9) == 81);
+}
+
+void testRejectsLayoutMismatch() {
+    LruCacheLinkedList<int, int> cache(2);
+    cache.put(1, 1);
+    const std::string path = tempPath("lru_snapshot_layout.bin");
+    lru_snapshot::save(cache, path);
+
+    bool exception_caught = false;
+    try {
+        lru_snapshot::load<int, double>(path, 2);
+    } catch (const std::runtime_error&) {
+        exception_caught = true;
+    }
+    std::filesystem::remove(path);
+    assert(exception_caught);
+}
+
+void testRejectsGarbageFile() {
+    const std::string path = tempPath("lru_snapshot_garbage.bin");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "definitely not a snapshot, but long enough for a header";
+    }
+    bool exception_caught = false;
+    try {
+        lru_snapshot::load<int, int>(path, 2);
+    } catch (const std::runtime_error&) {
+        exception_caught = true;
+    }
+    std::filesystem::remove(path);
+    assert(exception_caught);
+}
+
+void benchmarkWarmRestart() {
+    constexpr size_t entries = 2000000;
+    LruCacheLinkedList<long long, long long> cache(entries);
+    for (size_t i = 0; i < entries; ++i) {
+        cache.put(static_cast<long long>(i), static_cast<long long>(i));
+    }
+    const std::string path = tempPath("lru_snapshot_bench.bin");
+
+    auto start = std::chrono::steady_clock::now();
+    lru_snapshot::save(cache, path);
+    const std::chrono::duration<double> saveTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    auto restored = lru_snapshot::load<long long, long long>(path, entries);
+    const std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() - start;
+
+    const double megabytes = std::filesystem::file_size(path) / 1e6;
+    std::filesystem::remove(path);
+    assert(restored.size() == entries);
+
+    std::cout << "\nSnapshot of " << entries << " entries (" << megabytes << " MB)" << std::endl;
+    std::cout << "save\t" << saveTime.count() << " s" << std::endl;
+    std::cout << "load\t" << loadTime.count() << " s" << std::endl;
+}
+
+int main() {
+    test("Round Trip Preserves Recency", testRoundTripPreservesRecency);
+    test("Smaller Capacity Keeps Most Recent", testSmallerCapacityKeepsMostRecent);
+    test("Rejects Layout Mismatch", testRejectsLayoutMismatch);
+    test("Rejects Garbage File", testRejectsGarbageFile);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkWarmRestart();
+    return 0;
+}
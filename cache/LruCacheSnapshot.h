@@ -0,0 +1,202 @@
+#ifndef CPP_DATASTRUCTURES_LRUCACHESNAPSHOT_H
+#define CPP_DATASTRUCTURES_LRUCACHESNAPSHOT_H
+
+#include "LruCacheLinkedList.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Binary snapshots of an LruCacheLinkedList for warm restarts.
+ *
+ * For trivially copyable keys and values, the cache can be written out as a
+ * fixed header followed by a packed array of {key, value} records in recency
+ * order, least recent first. Loading maps the file with mmap and inserts the
+ * records straight from the mapping in file order, so the rebuilt cache has
+ * the same recency order, the mapping is read front to back, and no record is
+ * parsed or copied through a stream.
+ *
+ * Snapshots are only portable between builds with the same Key/Value layout
+ * and endianness; the header records sizes so a mismatch is rejected.
+ */
+namespace lru_snapshot {
+
+template <typename Key, typename Value>
+struct Record {
+    Key key;
+    Value value;
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t keySize;
+    uint32_t valueSize;
+    uint64_t count;
+};
+
+inline constexpr char kMagic[8] = {'L', 'R', 'U', 'S', 'N', 'A', 'P', '\0'};
+inline constexpr uint32_t kVersion = 2;
+
+template <typename Key, typename Value>
+concept Snapshottable = std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value> &&
+                        std::is_default_constructible_v<Key> && std::is_default_constructible_v<Value>;
+
+/**
+ * @brief Writes the cache to path, least recently used entry first.
+ *
+ * The snapshot is written to a temporary file next to path, synced to disk,
+ * renamed over path, and the directory is synced, so a crash leaves either
+ * the previous snapshot or the complete new one.
+ *
+ * @throws std::runtime_error if the file cannot be written.
+ */
+template <typename Key, typename Value, typename Stats>
+    requires Snapshottable<Key, Value>
+void save(const LruCacheLinkedList<Key, Value, Stats>& cache, const std::string& path) {
+    using R = Record<Key, Value>;
+    const std::string tmp = path + ".tmp";
+    std::FILE* file = std::fopen(tmp.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Cannot open snapshot file for writing: " + tmp);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.recordSize = sizeof(R);
+    header.keySize = sizeof(Key);
+    header.valueSize = sizeof(Value);
+    header.count = cache.size();
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // Stage records in fixed-size chunks so a multi-GB cache is written with
+    // a few large writes and bounded extra memory.
+    constexpr size_t chunkRecords = (size_t{1} << 20) / sizeof(R) + 1;
+    std::vector<R> chunk;
+    chunk.reserve(chunkRecords);
+    auto flush = [&] {
+        ok = ok && std::fwrite(chunk.data(), sizeof(R), chunk.size(), file) == chunk.size();
+        chunk.clear();
+    };
+    cache.forEachLeastRecentFirst([&](const Key& key, const Value& value) {
+        R record;
+        // Zero padding bytes so snapshots of equal caches are byte-identical.
+        std::memset(&record, 0, sizeof(record));
+        record.key = key;
+        record.value = value;
+        chunk.push_back(record);
+        if (chunk.size() == chunkRecords) {
+            flush();
+        }
+    });
+    flush();
+
+    // The data must be on disk before the rename can make it the snapshot.
+    ok = ok && std::fflush(file) == 0 && ::fsync(::fileno(file)) == 0;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::filesystem::remove(tmp);
+        throw std::runtime_error("Failed to write snapshot file: " + tmp);
+    }
+    std::filesystem::rename(tmp, path);
+
+    // The rename itself is durable only once the directory entry is synced.
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+    const int dirFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dirFd < 0) {
+        throw std::runtime_error("Cannot open snapshot directory: " + directory.string());
+    }
+    const bool synced = ::fsync(dirFd) == 0;
+    ::close(dirFd);
+    if (!synced) {
+        throw std::runtime_error("Failed to sync snapshot directory: " + directory.string());
+    }
+}
+
+/**
+ * @brief Rebuilds a cache from a snapshot written by save.
+ *
+ * If the snapshot holds more entries than capacity, only the most recently
+ * used `capacity` entries are loaded.
+ *
+ * @param path The snapshot file.
+ * @param capacity Capacity of the rebuilt cache.
+ * @throws std::runtime_error if the file is missing, truncated, or was written
+ *         for a different Key/Value layout.
+ */
+template <typename Key, typename Value>
+    requires Snapshottable<Key, Value>
+LruCacheLinkedList<Key, Value> load(const std::string& path, const size_t capacity) {
+    using R = Record<Key, Value>;
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open snapshot file: " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("Snapshot file is truncated: " + path);
+    }
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map snapshot file: " + path);
+    }
+
+    // Releases the mapping on every exit path, including exceptions.
+    struct Unmap {
+        void* address;
+        size_t length;
+        ~Unmap() { ::munmap(address, length); }
+    } unmap{mapping, fileSize};
+
+    const auto* bytes = static_cast<const unsigned char*>(mapping);
+    Header header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        throw std::runtime_error("Not an LRU snapshot: " + path);
+    }
+    if (header.recordSize != sizeof(R) || header.keySize != sizeof(Key) || header.valueSize != sizeof(Value)) {
+        throw std::runtime_error("Snapshot was written for a different key/value layout: " + path);
+    }
+    if (header.count > (fileSize - sizeof(Header)) / sizeof(R)) {
+        throw std::runtime_error("Snapshot file is truncated: " + path);
+    }
+
+    const size_t count = std::min<size_t>(header.count, capacity);
+    ::madvise(mapping, fileSize, MADV_SEQUENTIAL);
+
+    LruCacheLinkedList<Key, Value> cache(capacity);
+    cache.reserve(count);
+    // Records are least recent first, so the kept ones are the last count,
+    // and inserting them in file order leaves the newest at the front.
+    const unsigned char* records = bytes + sizeof(Header) + (header.count - count) * sizeof(R);
+    for (size_t i = 0; i < count; ++i) {
+        R record;
+        std::memcpy(&record, records + i * sizeof(R), sizeof(R));
+        cache.put(record.key, record.value);
+    }
+    return cache;
+}
+
+} // namespace lru_snapshot
+
+#endif //CPP_DATASTRUCTURES_LRUCACHESNAPSHOT_H
@@ -0,0 +1,180 @@
+#include "ShardedLruCache.h"
+#include "GlobalLockLruCache.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testBasicPutAndGet() {
+    ShardedLruCache<int, std::string> cache(64, 4);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    assert(cache.get(1) == "one");
+    assert(cache.get(2) == "two");
+    assert(cache.size() == 2);
+}
+
+void testShardCountRoundsToPowerOfTwo() {
+    ShardedLruCache<int, int> cache(100, 5);
+    assert(cache.shardCount() == 8);
+}
+
+void testCapacityIsExact() {
+    // 100 over 8 shards: four shards of 13 and four of 12.
+    ShardedLruCache<int, int> cache(100, 8);
+    assert(cache.capacity() == 100);
+    for (int i = 0; i < 100000; ++i) {
+        cache.put(i, i);
+    }
+    assert(cache.size() <= 100);
+
+    // The default shard count never exceeds a small capacity.
+    ShardedLruCache<int, int> small(3);
+    assert(small.shardCount() <= 2);
+    assert(small.capacity() == 3);
+    ShardedLruCache<int, int> empty(0);
+    assert(empty.capacity() == 0);
+}
+
+void testMissThrows() {
+    ShardedLruCache<int, std::string> cache(8, 2);
+    bool exception_caught = false;
+    try {
+        cache.get(42);
+    } catch (const std::out_of_range&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+void testSingleShardBehavesLikeLru() {
+    ShardedLruCache<int, std::string> cache(2, 1);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.get(1);
+    cache.put(3, "three");
+
+    bool exception_caught = false;
+    try {
+        cache.get(2);
+    } catch (const std::out_of_range&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+    assert(cache.get(1) == "one");
+    assert(cache.get(3) == "three");
+}
+
+void testCapacityIsBounded() {
+    ShardedLruCache<int, int> cache(64, 8);
+    for (int i = 0; i < 10000; ++i) {
+        cache.put(i, i);
+    }
+    // Each of the 8 shards holds at most 64 / 8 entries.
+    assert(cache.size() <= 64);
+}
+
+void testConcurrentAccess() {
+    ShardedLruCache<int, int> cache(1024, 16);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < 10000; ++i) {
+                const int key = (t * 131 + i) % 512;
+                cache.put(key, key * 2);
+                try {
+                    const int value = cache.get(key);
+                    assert(value % 2 == 0);
+                } catch (const std::out_of_range&) {
+                    // Another thread may have evicted it; that is fine.
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    assert(cache.size() <= 1024);
+}
+
+std::atomic<long long> benchmarkSink{0};
+
+// Runs a 90% get / 10% put mix over a key space that fits in the cache and
+// returns millions of operations per second.
+template <typename Cache>
+double runThroughput(Cache& cache, const int threads, const int opsPerThread, const int keySpace) {
+    for (int k = 0; k < keySpace; ++k) {
+        cache.put(k, k);
+    }
+
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&cache, t, opsPerThread, keySpace] {
+            std::mt19937 rng(t + 1);
+            std::uniform_int_distribution<int> keyDist(0, keySpace - 1);
+            long long sink = 0;
+            for (int i = 0; i < opsPerThread; ++i) {
+                const int key = keyDist(rng);
+                if (i % 10 == 0) {
+                    cache.put(key, i);
+                } else {
+                    sink += cache.get(key);
+                }
+            }
+            benchmarkSink += sink;
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threads * static_cast<double>(opsPerThread) / elapsed.count() / 1e6;
+}
+
+void benchmarkThroughput() {
+    std::cout << "\nThroughput (Mops/s), 90% get / 10% put, hardware threads: "
+              << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "threads\tglobal-lock\tsharded" << std::endl;
+
+    constexpr int keySpace = 1 << 16;
+    constexpr int opsPerThread = 200000;
+    for (int threads = 1; threads <= 32; threads *= 2) {
+        GlobalLockLruCache<int, int> baseline(keySpace);
+        // Shards fill unevenly, so give them slack to keep the run all hits.
+        ShardedLruCache<int, int> sharded(2 * keySpace, 128);
+        const double base = runThroughput(baseline, threads, opsPerThread, keySpace);
+        const double shard = runThroughput(sharded, threads, opsPerThread, keySpace);
+        std::cout << threads << "\t" << base << "\t\t" << shard << std::endl;
+    }
+}
+
+int main() {
+    test("Basic Put and Get", testBasicPutAndGet);
+    test("Shard Count Rounds To Power Of Two", testShardCountRoundsToPowerOfTwo);
+    test("Capacity Is Exact", testCapacityIsExact);
+    test("Miss Throws", testMissThrows);
+    test("Single Shard Behaves Like LRU", testSingleShardBehavesLikeLru);
+    test("Capacity Is Bounded", testCapacityIsBounded);
+    test("Concurrent Access", testConcurrentAccess);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkThroughput();
+    return 0;
+}
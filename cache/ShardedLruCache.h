@@ -0,0 +1,143 @@
+#ifndef CPP_DATASTRUCTURES_SHARDEDLRUCACHE_H
+#define CPP_DATASTRUCTURES_SHARDEDLRUCACHE_H
+
+#include "LruCacheLinkedList.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A thread-safe LRU cache that splits its keys across independent shards.
+ *
+ * Every shard is a plain LruCacheLinkedList guarded by its own mutex and owns an
+ * equal slice of the total capacity, give or take one entry. Since LruCacheLinkedList::get splices its
+ * recency list, a get is a write; giving each shard its own lock means threads
+ * touching different shards never contend, so throughput scales with cores.
+ *
+ * Recency is tracked per shard, so eviction is LRU within a shard and only
+ * approximately LRU across the whole cache.
+ *
+ * @tparam Key The key type. Must be hashable by Hash.
+ * @tparam Value The cached value type.
+ * @tparam Hash The hash functor used to pick a shard.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedLruCache {
+private:
+    // Each shard sits on its own cache line(s) so that neighbouring locks
+    // do not false-share.
+    struct alignas(64) Shard {
+        std::mutex mtx;
+        LruCacheLinkedList<Key, Value> lru;
+
+        explicit Shard(const size_t capacity) : lru(capacity) {}
+    };
+
+public:
+    /**
+     * @brief Constructs the cache.
+     *
+     * The shard count is rounded up to a power of two so that a shard can be
+     * picked with a mask. Each shard receives capacity / shards slots and the
+     * first capacity % shards shards one more, so the slots add up to exactly
+     * capacity. With more shards than capacity, the extra shards hold nothing.
+     *
+     * @param capacity Total number of entries across all shards.
+     * @param shardCount Number of shards; 0 picks 4x the hardware thread count,
+     *        reduced so that every shard has at least one slot.
+     */
+    explicit ShardedLruCache(const size_t capacity, size_t shardCount = 0) {
+        if (shardCount == 0) {
+            shardCount = 4 * std::max(1u, std::thread::hardware_concurrency());
+            shardCount = std::min(std::bit_ceil(shardCount), std::bit_floor(std::max<size_t>(capacity, 1)));
+        }
+        const size_t shards = std::bit_ceil(shardCount);
+        _mask = shards - 1;
+
+        _shards.reserve(shards);
+        for (size_t i = 0; i < shards; ++i) {
+            _shards.push_back(std::make_unique<Shard>(capacity / shards + (i < capacity % shards ? 1 : 0)));
+        }
+    }
+
+    /**
+     * @brief Gets the value associated with a key and marks it most recently used
+     * within its shard.
+     *
+     * @param key The key to look up.
+     * @return The value associated with the key.
+     * @throws std::out_of_range if the key is not in the cache.
+     */
+    Value get(const Key& key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        return shard.lru.get(key);
+    }
+
+    /**
+     * @brief Inserts or updates a key-value pair, evicting the LRU entry of the
+     * key's shard if that shard is full.
+     *
+     * @param key The key to insert or update.
+     * @param value The value associated with the key.
+     */
+    void put(const Key& key, const Value& value) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        shard.lru.put(key, value);
+    }
+
+    /**
+     * @brief Returns the number of entries across all shards.
+     *
+     * Shards are locked one at a time, so under concurrent writes the result is
+     * only a point-in-time estimate.
+     */
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : _shards) {
+            std::lock_guard<std::mutex> lock(shard->mtx);
+            total += shard->lru.size();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Returns the maximum number of entries across all shards.
+     */
+    size_t capacity() const {
+        size_t total = 0;
+        for (const auto& shard : _shards) {
+            total += shard->lru.capacity();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Returns the number of shards.
+     */
+    size_t shardCount() const { return _shards.size(); }
+
+private:
+    Shard& shardFor(const Key& key) {
+        // std::hash is the identity for integers, so mix the bits before
+        // masking or sequential keys would all land in the low shards.
+        uint64_t h = static_cast<uint64_t>(_hasher(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return *_shards[h & _mask];
+    }
+
+    std::vector<std::unique_ptr<Shard>> _shards;
+    size_t _mask = 0;
+    Hash _hasher;
+};
+
+#endif //CPP_DATASTRUCTURES_SHARDEDLRUCACHE_H
@@ -0,0 +1,193 @@
+#ifndef CPP_DATASTRUCTURES_SLABALLOCATOR_H
+#define CPP_DATASTRUCTURES_SLABALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief A memcached-style slab allocator over one fixed arena.
+ *
+ * The arena is reserved once and split into equal pages. Each page is handed
+ * to a size class on demand and carved into chunks of that class's size;
+ * chunk sizes grow geometrically by growthFactor, so a request wastes at most
+ * that fraction of its chunk. Freed chunks go back to their class and are
+ * reused before any new page is touched, so the arena never fragments: the
+ * only overhead is rounding up to the chunk size and the unused tail of each
+ * class's newest page.
+ *
+ * A page can be moved to another class with reassign once all its chunks are
+ * free, which lets the owner rebalance memory when the size mix drifts.
+ * Pages are zero-filled when assigned, so chunks that were never handed out
+ * read as zeros.
+ */
+class SlabAllocator {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Reserves the arena and computes the size classes.
+     * @param memoryLimit Arena size in bytes; rounded down to whole pages.
+     * @param pageSize Size of a page, which is also the largest chunk.
+     * @param growthFactor Ratio between consecutive chunk sizes.
+     * @param minChunkSize Size of the smallest chunk.
+     * @throws std::invalid_argument if the parameters cannot form size classes.
+     */
+    explicit SlabAllocator(const size_t memoryLimit, const size_t pageSize = size_t{1} << 20,
+                           const double growthFactor = 1.25, const size_t minChunkSize = 64)
+        : _pageSize(pageSize), _pageCount(pageSize == 0 ? 0 : memoryLimit / pageSize) {
+        if (growthFactor <= 1.0 || minChunkSize < kAlignment || minChunkSize > pageSize) {
+            throw std::invalid_argument("Invalid slab size class parameters.");
+        }
+        for (double size = static_cast<double>(minChunkSize); size < pageSize / 2.0; size *= growthFactor) {
+            size_t chunk = alignUp(static_cast<size_t>(size));
+            if (!_classes.empty() && chunk <= _classes.back().chunkSize) {
+                chunk = _classes.back().chunkSize + kAlignment;
+            }
+            _classes.emplace_back(chunk);
+        }
+        _classes.emplace_back(pageSize);
+        _arena = std::make_unique_for_overwrite<std::byte[]>(_pageCount * _pageSize);
+        _pageClass.assign(_pageCount, npos);
+    }
+
+    /**
+     * @brief Returns the smallest class whose chunks hold the given number of
+     * bytes, or classCount() if the request is larger than a page.
+     */
+    size_t classFor(const size_t bytes) const {
+        auto it = std::lower_bound(_classes.begin(), _classes.end(), bytes,
+                                   [](const SizeClass& c, const size_t b) { return c.chunkSize < b; });
+        return static_cast<size_t>(it - _classes.begin());
+    }
+
+    /**
+     * @brief Takes a chunk from the given class.
+     *
+     * Reuses a freed chunk if there is one, then carves the class's newest
+     * page, then assigns an untouched page of the arena to the class.
+     *
+     * @return The chunk, or nullptr if the class is full and the arena has no
+     *         unassigned pages left.
+     */
+    std::byte* allocate(const size_t cls) {
+        SizeClass& c = _classes[cls];
+        if (!c.free.empty()) {
+            std::byte* chunk = c.free.back();
+            c.free.pop_back();
+            return chunk;
+        }
+        if (c.carve == c.carveEnd) {
+            if (_nextPage == _pageCount) {
+                return nullptr;
+            }
+            assign(_nextPage++, cls);
+        }
+        std::byte* chunk = c.carve;
+        c.carve += c.chunkSize;
+        return chunk;
+    }
+
+    /**
+     * @brief Returns a chunk to the class it was allocated from.
+     */
+    void deallocate(std::byte* chunk, const size_t cls) { _classes[cls].free.push_back(chunk); }
+
+    /**
+     * @brief Moves a page to another class.
+     *
+     * Every chunk of the page must be free. The page is zero-filled and its
+     * chunks become available to the new class.
+     */
+    void reassign(const size_t page, const size_t cls) {
+        SizeClass& from = _classes[_pageClass[page]];
+        std::byte* begin = pageBegin(page);
+        std::byte* end = begin + _pageSize;
+        std::erase_if(from.free, [begin, end](const std::byte* chunk) { return chunk >= begin && chunk < end; });
+        if (from.carve >= begin && from.carve < end) {
+            from.carve = from.carveEnd = nullptr;
+        }
+        --from.pages;
+        assign(page, cls);
+    }
+
+    /**
+     * @brief Returns the page that contains a chunk.
+     */
+    size_t pageOf(const std::byte* chunk) const { return static_cast<size_t>(chunk - _arena.get()) / _pageSize; }
+
+    /**
+     * @brief Returns the first byte of a page.
+     */
+    std::byte* pageBegin(const size_t page) const { return _arena.get() + page * _pageSize; }
+
+    /**
+     * @brief Returns the class a page is assigned to, or npos if it is unused.
+     */
+    size_t pageClass(const size_t page) const { return _pageClass[page]; }
+
+    size_t classCount() const { return _classes.size(); }
+
+    size_t chunkSize(const size_t cls) const { return _classes[cls].chunkSize; }
+
+    size_t chunksPerPage(const size_t cls) const { return _pageSize / _classes[cls].chunkSize; }
+
+    /**
+     * @brief Returns the number of pages currently assigned to a class.
+     */
+    size_t pagesOf(const size_t cls) const { return _classes[cls].pages; }
+
+    /**
+     * @brief Returns the number of arena pages that have been assigned so far.
+     */
+    size_t assignedPages() const { return _nextPage; }
+
+    size_t pageCount() const { return _pageCount; }
+
+    size_t pageSize() const { return _pageSize; }
+
+private:
+    static constexpr size_t kAlignment = 8;
+
+    static size_t alignUp(const size_t size) { return (size + kAlignment - 1) & ~(kAlignment - 1); }
+
+    struct SizeClass {
+        explicit SizeClass(const size_t size) : chunkSize(size) {}
+
+        size_t chunkSize;
+        size_t pages = 0;
+        // Chunks returned by deallocate, reused last-in first-out.
+        std::vector<std::byte*> free;
+        // Unused tail of the class's newest page.
+        std::byte* carve = nullptr;
+        std::byte* carveEnd = nullptr;
+    };
+
+    void assign(const size_t page, const size_t cls) {
+        SizeClass& c = _classes[cls];
+        // Keep the uncarved rest of the previous page reachable.
+        for (; c.carve != c.carveEnd; c.carve += c.chunkSize) {
+            c.free.push_back(c.carve);
+        }
+        std::byte* begin = pageBegin(page);
+        std::memset(begin, 0, _pageSize);
+        _pageClass[page] = cls;
+        ++c.pages;
+        c.carve = begin;
+        c.carveEnd = begin + chunksPerPage(cls) * c.chunkSize;
+    }
+
+    size_t _pageSize;
+    size_t _pageCount;
+    size_t _nextPage = 0;
+
+    std::unique_ptr<std::byte[]> _arena;
+    std::vector<size_t> _pageClass;
+    std::vector<SizeClass> _classes;
+};
+
+#endif //CPP_DATASTRUCTURES_SLABALLOCATOR_H
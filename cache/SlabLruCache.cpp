@@ -0,0 +1,196 @@
+#include "SlabLruCache.h"
+#include "WeightedLruCache.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+bool contains(SlabLruCache<int>& cache, const int key) {
+    try {
+        cache.get(key);
+        return true;
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+}
+
+void testPutGetUpdate() {
+    SlabLruCache<int> cache(1 << 20, 1 << 16);
+    cache.put(1, "one");
+    cache.put(2, std::string(5000, 'x'));
+    assert(cache.get(1) == "one");
+    assert(cache.get(2) == std::string(5000, 'x'));
+
+    // Same size class, then a different one.
+    cache.put(1, "uno");
+    assert(cache.get(1) == "uno");
+    cache.put(1, std::string(300, 'y'));
+    assert(cache.get(1) == std::string(300, 'y'));
+    assert(cache.size() == 2);
+    assert(cache.liveBytes() == 5300);
+
+    assert(cache.erase(2));
+    assert(!cache.erase(2));
+    assert(!contains(cache, 2));
+    assert(cache.liveBytes() == 300);
+}
+
+// Pages of 1024 bytes with chunk sizes 64, 128, 256 and 1024.
+void testEvictsLeastRecentInClass() {
+    SlabLruCache<int> cache(1024, 1024, 2.0);
+    const std::string value(40, 'v');
+    for (int k = 0; k < 16; ++k) {
+        cache.put(k, value);
+    }
+    cache.get(0);
+    cache.put(16, value);
+    assert(!contains(cache, 1));
+    assert(contains(cache, 0));
+    assert(contains(cache, 16));
+    assert(cache.evictionCount() == 1);
+    assert(cache.pageMoveCount() == 0);
+}
+
+void testPageMovesToClassThatNeedsIt() {
+    SlabLruCache<int> cache(2048, 1024, 2.0);
+    for (int k = 0; k < 32; ++k) {
+        cache.put(k, std::string(40, 'a'));
+    }
+    // Both pages belong to the 64-byte class; a 200-byte value takes over the
+    // page holding the least recently used entry.
+    assert(cache.put(100, std::string(200, 'b')));
+    assert(cache.pageMoveCount() == 1);
+    for (int k = 0; k < 16; ++k) {
+        assert(!contains(cache, k));
+    }
+    for (int k = 16; k < 32; ++k) {
+        assert(contains(cache, k));
+    }
+    assert(cache.get(100) == std::string(200, 'b'));
+    assert(cache.allocatedBytes() == 2048);
+}
+
+void testRejectsOversizedAndDropsStale() {
+    SlabLruCache<int> cache(4096, 1024, 2.0);
+    cache.put(1, "small");
+    assert(!cache.put(1, std::string(2000, 'z')));
+    assert(!contains(cache, 1));
+    assert(cache.rejectionCount() == 1);
+    assert(cache.liveBytes() == 0);
+}
+
+void testRandomChurnMatchesLastWrite() {
+    SlabLruCache<int> cache(1 << 16, 4096);
+    std::unordered_map<int, std::string> last;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> keyDist(0, 999);
+    std::uniform_int_distribution<int> sizeDist(0, 1500);
+    for (int i = 0; i < 50000; ++i) {
+        const int key = keyDist(rng);
+        if (i % 3 == 0) {
+            std::string value(sizeDist(rng), static_cast<char>('a' + i % 26));
+            assert(cache.put(key, value));
+            last[key] = std::move(value);
+        } else {
+            try {
+                assert(cache.get(key) == last.at(key));
+            } catch (const std::out_of_range&) {
+                // Evicted or never written.
+            }
+        }
+        assert(cache.allocatedBytes() <= (1 << 16));
+    }
+}
+
+size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// Simulates a day of traffic in 24 "hours" of overwrites whose value sizes
+// drift from ~100 bytes up to ~3 KB and back, reporting RSS against the bytes
+// actually stored.
+template <typename Cache>
+void churn(const std::string& label, Cache& cache, const std::function<size_t(const Cache&)>& liveBytes) {
+    constexpr uint64_t keySpace = 1000000;
+    constexpr int putsPerHour = 200000;
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint64_t> keyDist(0, keySpace - 1);
+    std::uniform_real_distribution<double> jitter(0.5, 1.5);
+
+    std::cout << "\n" << label << std::endl;
+    std::cout << "hour\tlive MB\tRSS MB\tRSS/live" << std::endl;
+    for (int hour = 0; hour < 24; ++hour) {
+        const double phase = 1.0 - std::abs(hour - 12) / 12.0;
+        const double meanSize = 100.0 * std::pow(32.0, phase);
+        for (int i = 0; i < putsPerHour; ++i) {
+            const auto size = static_cast<size_t>(meanSize * jitter(rng));
+            cache.put(keyDist(rng), std::string(size, 'x'));
+        }
+        if (hour % 3 == 2) {
+            const double live = liveBytes(cache) / 1e6;
+            const double rss = residentBytes() / 1e6;
+            std::cout << hour + 1 << "\t" << live << "\t" << rss << "\t" << rss / live << std::endl;
+        }
+    }
+}
+
+// Each run gets a fresh process so one heap does not pollute the other's RSS.
+void runIsolated(const std::function<void()>& run) {
+    std::cout.flush();
+    const pid_t pid = fork();
+    if (pid == 0) {
+        run();
+        std::cout.flush();
+        _exit(0);
+    }
+    waitpid(pid, nullptr, 0);
+}
+
+void benchmarkChurnFootprint() {
+    constexpr size_t budget = 64 << 20;
+    runIsolated([] {
+        using Heap = WeightedLruCache<uint64_t, std::string>;
+        Heap cache(budget, [](const uint64_t&, const std::string& v) { return v.size(); });
+        churn<Heap>("std::string values (WeightedLruCache, 64 MB budget)", cache,
+                    [](const Heap& c) { return c.weight(); });
+    });
+    runIsolated([] {
+        using Slab = SlabLruCache<uint64_t>;
+        Slab cache(budget);
+        churn<Slab>("slab values (SlabLruCache, 64 MB arena)", cache, [](const Slab& c) { return c.liveBytes(); });
+    });
+}
+
+int main() {
+    test("Put Get Update", testPutGetUpdate);
+    test("Evicts Least Recent In Class", testEvictsLeastRecentInClass);
+    test("Page Moves To Class That Needs It", testPageMovesToClassThatNeedsIt);
+    test("Rejects Oversized And Drops Stale", testRejectsOversizedAndDropsStale);
+    test("Random Churn Matches Last Write", testRandomChurnMatchesLastWrite);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkChurnFootprint();
+    return 0;
+}
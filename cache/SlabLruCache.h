@@ -0,0 +1,257 @@
+#ifndef CPP_DATASTRUCTURES_SLABLRUCACHE_H
+#define CPP_DATASTRUCTURES_SLABLRUCACHE_H
+
+#include "SlabAllocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief An LRU cache of byte-string values stored off-heap in slab chunks.
+ *
+ * LruCacheLinkedList<Key, std::string> allocates every value separately, so
+ * under long-running churn with a drifting size mix the heap fragments and
+ * RSS creeps away from the live data. Here values are copied into chunks of a
+ * SlabAllocator arena whose size is fixed up front, so value memory never
+ * exceeds memoryLimit no matter how long the cache runs.
+ *
+ * As in memcached, each size class has its own LRU list, and a put that finds
+ * its class full evicts the globally least recently used entry: if that entry
+ * is in the same class its chunk is reused, otherwise the whole page holding
+ * it is emptied and moved to the class that needs memory. Pages thus follow
+ * the size mix instead of staying stuck in classes that are no longer used.
+ *
+ * Each chunk starts with a small header holding the value length and a pointer
+ * back to its index entry, which is what lets a page be emptied.
+ *
+ * @tparam Key The key type.
+ * @tparam Hash The hash functor for Key.
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class SlabLruCache {
+private:
+    struct CacheEntry;
+    using Node = std::pair<const Key, CacheEntry>;
+
+    struct CacheEntry {
+        std::byte* chunk = nullptr;
+        typename std::list<Node*>::iterator list_iterator;
+        // Value of _tick at the last access; smaller is less recent.
+        uint64_t stamp = 0;
+        size_t cls = 0;
+    };
+
+    struct ChunkHeader {
+        // Null while the chunk is free.
+        Node* owner;
+        size_t length;
+    };
+
+public:
+    /**
+     * @brief Constructs the cache.
+     * @param memoryLimit Bytes reserved for values, including chunk headers.
+     * @param pageSize Slab page size, which also bounds the largest value.
+     * @param growthFactor Ratio between consecutive chunk sizes.
+     */
+    explicit SlabLruCache(const size_t memoryLimit, const size_t pageSize = size_t{1} << 20,
+                          const double growthFactor = 1.25)
+        : _slabs(memoryLimit, pageSize, growthFactor), _lru(_slabs.classCount()) {}
+
+    /**
+     * @brief Gets a copy of the value associated with a key and marks it most
+     * recently used.
+     *
+     * @param key The key to look up.
+     * @return The value associated with the key.
+     * @throws std::out_of_range if the key is not in the cache.
+     */
+    std::string get(const Key& key) {
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            throw std::out_of_range("Key not found in cache.");
+        }
+        touch(it->second);
+        const ChunkHeader header = headerOf(it->second.chunk);
+        return std::string(reinterpret_cast<const char*>(it->second.chunk + sizeof(ChunkHeader)), header.length);
+    }
+
+    /**
+     * @brief Copies a value into the cache, evicting as needed.
+     *
+     * A value that does not fit in a page is rejected, and any existing entry
+     * for the key is removed so a stale value is never served.
+     *
+     * @param key The key to insert or update.
+     * @param value The bytes to store.
+     * @return true if the value was stored, false if it was rejected.
+     */
+    bool put(const Key& key, const std::string_view value) {
+        const size_t cls = _slabs.classFor(sizeof(ChunkHeader) + value.size());
+        auto it = _cache.find(key);
+        if (it != _cache.end()) {
+            if (it->second.cls == cls) {
+                _liveBytes += value.size() - headerOf(it->second.chunk).length;
+                write(it->second.chunk, &*it, value);
+                touch(it->second);
+                return true;
+            }
+            remove(it);
+        }
+        if (cls == _slabs.classCount()) {
+            ++_rejections;
+            return false;
+        }
+
+        std::byte* chunk = _slabs.allocate(cls);
+        if (!chunk) {
+            makeRoom(cls);
+            chunk = _slabs.allocate(cls);
+            if (!chunk) {
+                ++_rejections;
+                return false;
+            }
+        }
+
+        Node* node = &*_cache.try_emplace(key).first;
+        _lru[cls].push_front(node);
+        node->second = CacheEntry{chunk, _lru[cls].begin(), ++_tick, cls};
+        write(chunk, node, value);
+        _liveBytes += value.size();
+        return true;
+    }
+
+    /**
+     * @brief Removes a key and frees its chunk.
+     * @return true if the key was present.
+     */
+    bool erase(const Key& key) {
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            return false;
+        }
+        remove(it);
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of entries currently held by the cache.
+     */
+    size_t size() const { return _cache.size(); }
+
+    /**
+     * @brief Returns the total length of the stored values.
+     */
+    size_t liveBytes() const { return _liveBytes; }
+
+    /**
+     * @brief Returns the bytes of the arena handed out to size classes so far;
+     * never more than the memory limit.
+     */
+    size_t allocatedBytes() const { return _slabs.assignedPages() * _slabs.pageSize(); }
+
+    /**
+     * @brief Returns the number of entries evicted to make room.
+     */
+    size_t evictionCount() const { return _evictions; }
+
+    /**
+     * @brief Returns the number of pages moved between size classes.
+     */
+    size_t pageMoveCount() const { return _pageMoves; }
+
+    /**
+     * @brief Returns the number of puts rejected for not fitting.
+     */
+    size_t rejectionCount() const { return _rejections; }
+
+private:
+    static ChunkHeader headerOf(const std::byte* chunk) {
+        ChunkHeader header;
+        std::memcpy(&header, chunk, sizeof(header));
+        return header;
+    }
+
+    static void write(std::byte* chunk, Node* owner, const std::string_view value) {
+        const ChunkHeader header{owner, value.size()};
+        std::memcpy(chunk, &header, sizeof(header));
+        std::memcpy(chunk + sizeof(header), value.data(), value.size());
+    }
+
+    void touch(CacheEntry& entry) {
+        std::list<Node*>& lru = _lru[entry.cls];
+        lru.splice(lru.begin(), lru, entry.list_iterator);
+        entry.stamp = ++_tick;
+    }
+
+    void remove(typename std::unordered_map<Key, CacheEntry, Hash>::iterator it) {
+        CacheEntry& entry = it->second;
+        _liveBytes -= headerOf(entry.chunk).length;
+        const ChunkHeader freed{nullptr, 0};
+        std::memcpy(entry.chunk, &freed, sizeof(freed));
+        _slabs.deallocate(entry.chunk, entry.cls);
+        _lru[entry.cls].erase(entry.list_iterator);
+        _cache.erase(it);
+    }
+
+    void evict(Node* node) {
+        remove(_cache.find(node->first));
+        ++_evictions;
+    }
+
+    // Frees memory for class cls by evicting the globally least recently used
+    // entry, moving the page that held it to cls if it belongs to another class.
+    void makeRoom(const size_t cls) {
+        size_t donor = SlabAllocator::npos;
+        uint64_t oldest = UINT64_MAX;
+        for (size_t c = 0; c < _lru.size(); ++c) {
+            if (!_lru[c].empty() && _lru[c].back()->second.stamp < oldest) {
+                oldest = _lru[c].back()->second.stamp;
+                donor = c;
+            }
+        }
+        if (donor == SlabAllocator::npos) {
+            return;
+        }
+        if (donor == cls) {
+            evict(_lru[cls].back());
+            return;
+        }
+
+        const size_t page = _slabs.pageOf(_lru[donor].back()->second.chunk);
+        const size_t chunkSize = _slabs.chunkSize(donor);
+        std::byte* begin = _slabs.pageBegin(page);
+        for (size_t i = 0; i < _slabs.chunksPerPage(donor); ++i) {
+            if (Node* owner = headerOf(begin + i * chunkSize).owner) {
+                evict(owner);
+            }
+        }
+        _slabs.reassign(page, cls);
+        ++_pageMoves;
+    }
+
+    SlabAllocator _slabs;
+
+    // One LRU list per size class, most recently used first.
+    std::vector<std::list<Node*>> _lru;
+
+    // Map nodes are never moved, so chunk headers and lists can point at them.
+    std::unordered_map<Key, CacheEntry, Hash> _cache;
+
+    uint64_t _tick = 0;
+    size_t _liveBytes = 0;
+    size_t _evictions = 0;
+    size_t _pageMoves = 0;
+    size_t _rejections = 0;
+};
+
+#endif //CPP_DATASTRUCTURES_SLABLRUCACHE_H
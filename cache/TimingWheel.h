@@ -0,0 +1,200 @@
+#ifndef CPP_DATASTRUCTURES_TIMINGWHEEL_H
+#define CPP_DATASTRUCTURES_TIMINGWHEEL_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <utility>
+
+/**
+ * @brief A hierarchical timing wheel keyed by integer ticks.
+ *
+ * Timers live in `Levels` wheels of 64 slots each. Level 0 has one slot per
+ * tick, level 1 one slot per 64 ticks, and so on, so four levels cover 2^24
+ * ticks before deadlines are clamped to the farthest slot (they are re-filed
+ * when that slot cascades). Scheduling and cancelling are O(1); each timer is
+ * moved down at most `Levels - 1` times before it fires.
+ *
+ * Each level keeps a 64-bit mask of its non-empty slots. Rotating the mask to
+ * start at the next slot the level reaches and counting trailing zeros gives
+ * that level's next firing or cascade, so advance jumps straight to the
+ * earliest one and skips idle ticks. Advancing costs O(1) amortized per timer
+ * plus O(Levels) per tick at which something fires or cascades, however long
+ * the wheel sat idle.
+ *
+ * Each slot is a std::list, and a timer keeps its node for its whole life (it
+ * is spliced between slots), so the handle returned by schedule stays valid
+ * until the timer fires or is cancelled.
+ *
+ * @tparam Key The payload delivered to the expiry callback.
+ * @tparam Levels Number of wheel levels.
+ */
+template <typename Key, size_t Levels = 4>
+class TimingWheel {
+private:
+    static constexpr unsigned bitsPerLevel = 6;
+    static constexpr uint64_t slotsPerLevel = uint64_t{1} << bitsPerLevel;
+    static constexpr uint64_t slotMask = slotsPerLevel - 1;
+
+    struct Timer {
+        Key key;
+        uint64_t deadline;
+        size_t level = 0;
+        size_t slot = 0;
+    };
+
+    using Slot = std::list<Timer>;
+
+public:
+    using Handle = typename Slot::iterator;
+
+    explicit TimingWheel(const uint64_t startTick = 0) : _now(startTick) {}
+
+    /**
+     * @brief Schedules key to fire once the wheel reaches deadline.
+     *
+     * A deadline at or before the current tick fires on the next advance.
+     *
+     * @return A handle that can be passed to cancel until the timer fires.
+     */
+    Handle schedule(const Key& key, const uint64_t deadline) {
+        Slot staging;
+        staging.push_back(Timer{key, deadline});
+        const Handle handle = staging.begin();
+        // The current tick's slot has already fired, so the soonest a new
+        // timer can fire is the next tick.
+        place(staging, handle, _now + 1);
+        ++_size;
+        return handle;
+    }
+
+    /**
+     * @brief Removes a pending timer.
+     * @param handle A handle returned by schedule whose timer has not fired.
+     */
+    void cancel(const Handle handle) {
+        const size_t level = handle->level;
+        const size_t slot = handle->slot;
+        _wheels[level][slot].erase(handle);
+        if (_wheels[level][slot].empty()) {
+            _occupied[level] &= ~(uint64_t{1} << slot);
+        }
+        --_size;
+    }
+
+    /**
+     * @brief Advances the wheel to tick `to`, firing every timer that is due.
+     *
+     * @param to The new current tick; ignored if not ahead of the current one.
+     * @param onExpire Called with each expired key. It must not schedule or
+     *                 cancel timers.
+     */
+    template <typename Callback>
+    void advance(const uint64_t to, Callback&& onExpire) {
+        while (_now < to) {
+            // Nothing fires or cascades before the next event, so the ticks
+            // up to it can be skipped.
+            const uint64_t next = nextEvent();
+            if (next > to) {
+                _now = to;
+                return;
+            }
+            _now = next;
+            cascade();
+
+            Slot& due = _wheels[0][_now & slotMask];
+            while (!due.empty()) {
+                Key key = std::move(due.front().key);
+                due.pop_front();
+                --_size;
+                onExpire(key);
+            }
+            _occupied[0] &= ~(uint64_t{1} << (_now & slotMask));
+        }
+    }
+
+    /**
+     * @brief Returns the current tick.
+     */
+    uint64_t now() const { return _now; }
+
+    /**
+     * @brief Returns the number of pending timers.
+     */
+    size_t size() const { return _size; }
+
+private:
+    // The first tick after the current one at which a level-0 slot fires or
+    // a non-empty slot of a higher level cascades, or the largest tick if no
+    // timer is pending. Level L reaches its slots at multiples of 64^L.
+    uint64_t nextEvent() const {
+        uint64_t next = std::numeric_limits<uint64_t>::max();
+        for (size_t level = 0; level < Levels; ++level) {
+            if (_occupied[level] == 0) {
+                continue;
+            }
+            const unsigned shift = static_cast<unsigned>(level) * bitsPerLevel;
+            const uint64_t period = (_now >> shift) + 1;
+            // Bit i is the slot reached i periods from now.
+            const uint64_t ahead = std::rotr(_occupied[level], static_cast<int>(period & slotMask));
+            next = std::min(next, (period + std::countr_zero(ahead)) << shift);
+        }
+        return next;
+    }
+
+    // When a lower level wraps around, re-file the timers of the next slot of
+    // the level above into finer slots. Higher levels go first so that their
+    // timers can fall through the levels below within the same tick.
+    void cascade() {
+        size_t top = 0;
+        while (top + 1 < Levels && ((_now >> (top * bitsPerLevel)) & slotMask) == 0) {
+            ++top;
+        }
+        for (size_t level = top; level >= 1; --level) {
+            const size_t index = (_now >> (level * bitsPerLevel)) & slotMask;
+            Slot& slot = _wheels[level][index];
+            while (!slot.empty()) {
+                place(slot, slot.begin(), _now);
+            }
+            _occupied[level] &= ~(uint64_t{1} << index);
+        }
+    }
+
+    // Splices the timer at `it` out of `from` into the slot matching its
+    // deadline, treating deadlines before `earliest` as `earliest`.
+    void place(Slot& from, const Handle it, const uint64_t earliest) {
+        const uint64_t deadline = it->deadline > earliest ? it->deadline : earliest;
+        const uint64_t delta = deadline - _now;
+
+        size_t level = 0;
+        while (level + 1 < Levels && delta >= (uint64_t{1} << ((level + 1) * bitsPerLevel))) {
+            ++level;
+        }
+
+        size_t slot;
+        if (delta >= (uint64_t{1} << (Levels * bitsPerLevel))) {
+            // Beyond the wheel's horizon: park in the farthest top-level slot.
+            slot = ((_now >> (level * bitsPerLevel)) - 1) & slotMask;
+        } else {
+            slot = (deadline >> (level * bitsPerLevel)) & slotMask;
+        }
+
+        it->level = level;
+        it->slot = slot;
+        Slot& to = _wheels[level][slot];
+        to.splice(to.end(), from, it);
+        _occupied[level] |= uint64_t{1} << slot;
+    }
+
+    std::array<std::array<Slot, slotsPerLevel>, Levels> _wheels;
+    // Bit s of _occupied[level] is set while _wheels[level][s] is non-empty.
+    std::array<uint64_t, Levels> _occupied{};
+    uint64_t _now;
+    size_t _size = 0;
+};
+
+#endif //CPP_DATASTRUCTURES_TIMINGWHEEL_H
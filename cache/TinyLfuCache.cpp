@@ -0,0 +1,178 @@
+#include "TinyLfuCache.h"
+#include "CacheTraces.h"
+#include "LruCacheLinkedList.h"
+#include <iostream>
+#include <cassert>
+#include <functional>
+#include <string>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testSketchCountsAndSaturates() {
+    FrequencySketch<int> sketch(64);
+    for (int i = 0; i < 5; ++i) {
+        sketch.increment(7);
+    }
+    assert(sketch.estimate(7) >= 5);
+    for (int i = 0; i < 100; ++i) {
+        sketch.increment(7);
+    }
+    assert(sketch.estimate(7) == 15);
+}
+
+void testSketchAging() {
+    FrequencySketch<int> sketch(16);
+    for (int i = 0; i < 12; ++i) {
+        sketch.increment(1);
+    }
+    const uint32_t before = sketch.estimate(1);
+    // 10 * width additions trigger a reset that halves every counter.
+    for (int i = 0; i < 200; ++i) {
+        sketch.increment(1000 + i);
+    }
+    assert(sketch.estimate(1) < before);
+}
+
+void testBasicPutAndGet() {
+    TinyLfuCache<int, std::string> cache(100);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    assert(cache.get(1) == "one");
+    assert(cache.get(2) == "two");
+    cache.put(1, "uno");
+    assert(cache.get(1) == "uno");
+}
+
+void testMissThrows() {
+    TinyLfuCache<int, std::string> cache(10);
+    bool exception_caught = false;
+    try {
+        cache.get(10);
+    } catch (const std::out_of_range&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+void testZeroCapacity() {
+    TinyLfuCache<int, std::string> cache(0);
+    cache.put(1, "one");
+    assert(cache.size() == 0);
+}
+
+void testScanDoesNotFlushHotSet() {
+    TinyLfuCache<int, int> cache(100);
+    // Build up frequency for a hot set that fills the main region.
+    for (int round = 0; round < 5; ++round) {
+        for (int k = 0; k < 90; ++k) {
+            try {
+                cache.get(k);
+            } catch (const std::out_of_range&) {
+                cache.put(k, k);
+            }
+        }
+    }
+    // A scan of one-off keys only churns the window.
+    for (int k = 1000; k < 2000; ++k) {
+        cache.put(k, k);
+    }
+    int survivors = 0;
+    for (int k = 0; k < 90; ++k) {
+        try {
+            cache.get(k);
+            ++survivors;
+        } catch (const std::out_of_range&) {
+        }
+    }
+    assert(survivors >= 85);
+    assert(cache.size() <= 100);
+}
+
+void testPutsCountTowardAdmission() {
+    // Window of 1, main of 99, filled with keys written once.
+    TinyLfuCache<int, int> cache(100);
+    for (int k = 0; k < 100; ++k) {
+        cache.put(k, k);
+    }
+    // A key written repeatedly, and never read, beats a victim written once.
+    for (int round = 0; round < 5; ++round) {
+        cache.put(500, round);
+    }
+    cache.put(600, 600);
+    assert(cache.get(500) == 4);
+}
+
+// Replays writes through put and reads through get, one of each per step. A
+// missed read does not fill the cache, so only puts insert keys.
+template <typename Cache>
+double putOnlyHitRatio(Cache& cache, const std::vector<uint64_t>& writes, const std::vector<uint64_t>& reads) {
+    size_t hits = 0;
+    for (size_t i = 0; i < reads.size(); ++i) {
+        cache.put(writes[i], writes[i]);
+        try {
+            cache.get(reads[i]);
+            ++hits;
+        } catch (const std::out_of_range&) {
+        }
+    }
+    return reads.empty() ? 0.0 : static_cast<double>(hits) / reads.size();
+}
+
+void benchmarkHitRatio() {
+    constexpr size_t capacity = 5000;
+    constexpr size_t keySpace = 50000;
+    constexpr size_t length = 300000;
+
+    struct Shape {
+        std::string name;
+        std::vector<uint64_t> trace;
+    };
+    const std::vector<Shape> shapes = {
+        {"zipf 0.9", cache_traces::zipf(length, keySpace, 0.9)},
+        {"loop 6000", cache_traces::loop(length, 6000)},
+        {"zipf+scans", cache_traces::scanMixed(length, keySpace, 0.9, 20000, 20000)},
+    };
+
+    std::cout << "\nHit ratio, capacity " << capacity << std::endl;
+    std::cout << "trace\t\tLRU\t\tW-TinyLFU" << std::endl;
+    size_t sketchBytes = 0;
+    for (const auto& shape : shapes) {
+        LruCacheLinkedList<uint64_t, uint64_t> lru(capacity);
+        TinyLfuCache<uint64_t, uint64_t> tinyLfu(capacity);
+        sketchBytes = tinyLfu.sketchBytes();
+        std::cout << shape.name << "\t" << cache_traces::hitRatio(lru, shape.trace) << "\t"
+                  << cache_traces::hitRatio(tinyLfu, shape.trace) << std::endl;
+    }
+    std::cout << "sketch memory: " << sketchBytes << " bytes" << std::endl;
+
+    // Writes and reads follow the same Zipf popularity but are drawn apart.
+    const auto writes = cache_traces::zipf(length, keySpace, 0.9, 2);
+    const auto reads = cache_traces::zipf(length, keySpace, 0.9, 3);
+    LruCacheLinkedList<uint64_t, uint64_t> lru(capacity);
+    TinyLfuCache<uint64_t, uint64_t> tinyLfu(capacity);
+    std::cout << "zipf 0.9, put-only inserts	" << putOnlyHitRatio(lru, writes, reads) << "	"
+              << putOnlyHitRatio(tinyLfu, writes, reads) << std::endl;
+}
+
+int main() {
+    test("Sketch Counts And Saturates", testSketchCountsAndSaturates);
+    test("Sketch Aging", testSketchAging);
+    test("Basic Put and Get", testBasicPutAndGet);
+    test("Miss Throws", testMissThrows);
+    test("Zero Capacity", testZeroCapacity);
+    test("Scan Does Not Flush Hot Set", testScanDoesNotFlushHotSet);
+    test("Puts Count Toward Admission", testPutsCountTowardAdmission);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkHitRatio();
+    return 0;
+}
@@ -0,0 +1,138 @@
+#ifndef CPP_DATASTRUCTURES_TINYLFUCACHE_H
+#define CPP_DATASTRUCTURES_TINYLFUCACHE_H
+
+#include "FrequencySketch.h"
+#include "LruCacheLinkedList.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+/**
+ * @brief An LRU cache guarded by a W-TinyLFU admission filter.
+ *
+ * A plain LRU admits every new key and evicts its tail, so a one-off scan
+ * longer than the cache flushes the whole hot set. Here new keys first land in
+ * a small window LRU (about 1% of the capacity). When the window overflows,
+ * its victim becomes a candidate for the main LRU and is admitted only if the
+ * frequency sketch estimates it has been seen more often than the main LRU's
+ * own victim; otherwise the candidate is dropped and the main LRU is left
+ * untouched.
+ *
+ * The window absorbs bursts of new keys, the sketch's periodic aging lets the
+ * filter adapt when popularity shifts, and the sketch memory is fixed at
+ * construction.
+ *
+ * @tparam Key The key type. Must be hashable by Hash.
+ * @tparam Value The cached value type.
+ * @tparam Hash The hash functor used by the frequency sketch.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class TinyLfuCache {
+public:
+    /**
+     * @brief Constructs the cache.
+     * @param capacity Total number of entries across the window and main LRU.
+     * @param sketchCounters Counters per sketch row; 0 gives four per entry,
+     *        8 bytes of sketch per entry, so the one-off keys a scan puts do
+     *        not pile up in the counters of the hot set.
+     */
+    explicit TinyLfuCache(const size_t capacity, const size_t sketchCounters = 0)
+        : _window(windowCapacity(capacity)),
+          _main(capacity - windowCapacity(capacity)),
+          _sketch(sketchCounters == 0 ? 4 * capacity : sketchCounters) {}
+
+    /**
+     * @brief Gets the value associated with a key and records the access.
+     *
+     * Misses are recorded too, so a key that keeps being requested builds up
+     * enough frequency to be admitted later.
+     *
+     * @param key The key to look up.
+     * @return The value associated with the key.
+     * @throws std::out_of_range if the key is not in the cache.
+     */
+    Value get(const Key& key) {
+        _sketch.increment(key);
+        if (_window.contains(key)) {
+            return _window.get(key);
+        }
+        return _main.get(key);
+    }
+
+    /**
+     * @brief Inserts or updates a key-value pair.
+     *
+     * The write is recorded like an access, so keys that are only ever put
+     * still build up frequency. An existing key is updated in place. A new key
+     * enters the window; if that pushes a candidate out of the window, the
+     * candidate competes with the main LRU's victim for a slot.
+     *
+     * @param key The key to insert or update.
+     * @param value The value associated with the key.
+     */
+    void put(const Key& key, const Value& value) {
+        _sketch.increment(key);
+        if (_window.contains(key)) {
+            _window.put(key, value);
+            return;
+        }
+        if (_main.contains(key)) {
+            _main.put(key, value);
+            return;
+        }
+
+        // Check for edge case of 0 capacity
+        if (_window.capacity() == 0) {
+            return;
+        }
+
+        if (_window.size() < _window.capacity()) {
+            _window.put(key, value);
+            return;
+        }
+
+        auto candidate = _window.evictLeastRecent();
+        _window.put(key, value);
+        admit(std::move(candidate));
+    }
+
+    /**
+     * @brief Returns the number of entries currently held by the cache.
+     */
+    size_t size() const { return _window.size() + _main.size(); }
+
+    /**
+     * @brief Returns the memory used by the frequency sketch, in bytes.
+     */
+    size_t sketchBytes() const { return _sketch.memoryBytes(); }
+
+private:
+    static size_t windowCapacity(const size_t capacity) {
+        return capacity == 0 ? 0 : std::max<size_t>(1, capacity / 100);
+    }
+
+    void admit(std::pair<Key, Value> candidate) {
+        if (_main.capacity() == 0) {
+            return;
+        }
+        if (_main.size() < _main.capacity()) {
+            _main.put(candidate.first, candidate.second);
+            return;
+        }
+        if (_sketch.estimate(candidate.first) > _sketch.estimate(_main.leastRecentKey())) {
+            _main.evictLeastRecent();
+            _main.put(candidate.first, candidate.second);
+        }
+    }
+
+    // Admission window: every new key starts here.
+    LruCacheLinkedList<Key, Value> _window;
+
+    // Main region, protected by the frequency filter.
+    LruCacheLinkedList<Key, Value> _main;
+
+    FrequencySketch<Key, Hash> _sketch;
+};
+
+#endif //CPP_DATASTRUCTURES_TINYLFUCACHE_H
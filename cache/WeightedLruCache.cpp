@@ -0,0 +1,108 @@
+#include "WeightedLruCache.h"
+#include <iostream>
+#include <cassert>
+#include <functional>
+#include <string>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+size_t stringBytes(const int&, const std::string& value) {
+    return value.size();
+}
+
+bool contains(WeightedLruCache<int, std::string>& cache, const int key) {
+    try {
+        cache.get(key);
+        return true;
+    } catch (const std::out_of_range&) {
+        return false;
+    }
+}
+
+void testTracksWeight() {
+    WeightedLruCache<int, std::string> cache(100, stringBytes);
+    cache.put(1, std::string(10, 'a'));
+    cache.put(2, std::string(30, 'b'));
+    assert(cache.weight() == 40);
+    assert(cache.size() == 2);
+    assert(cache.get(2).size() == 30);
+}
+
+void testEvictsAsManyAsNeeded() {
+    WeightedLruCache<int, std::string> cache(100, stringBytes);
+    cache.put(1, std::string(30, 'a'));
+    cache.put(2, std::string(30, 'b'));
+    cache.put(3, std::string(30, 'c'));
+    cache.get(1);
+
+    // Needs 80 bytes: evicts 2 then 3, keeps the recently used 1.
+    assert(cache.put(4, std::string(70, 'd')));
+    assert(contains(cache, 1));
+    assert(!contains(cache, 2));
+    assert(!contains(cache, 3));
+    assert(cache.weight() == 100);
+    assert(cache.evictionCount() == 2);
+    assert(cache.evictedWeight() == 60);
+}
+
+void testRejectsOversizedEntry() {
+    WeightedLruCache<int, std::string> cache(50, stringBytes);
+    cache.put(1, std::string(20, 'a'));
+    assert(!cache.put(2, std::string(51, 'b')));
+    assert(cache.rejectionCount() == 1);
+    assert(!contains(cache, 2));
+    // Rejection must not evict anything.
+    assert(contains(cache, 1));
+    assert(cache.weight() == 20);
+}
+
+void testOversizedUpdateDropsStaleValue() {
+    WeightedLruCache<int, std::string> cache(50, stringBytes);
+    cache.put(1, std::string(20, 'a'));
+    assert(!cache.put(1, std::string(60, 'b')));
+    assert(!contains(cache, 1));
+    assert(cache.weight() == 0);
+}
+
+void testHeavierUpdateEvictsOthers() {
+    WeightedLruCache<int, std::string> cache(100, stringBytes);
+    cache.put(1, std::string(40, 'a'));
+    cache.put(2, std::string(40, 'b'));
+    cache.put(1, std::string(90, 'c'));
+    assert(contains(cache, 1));
+    assert(!contains(cache, 2));
+    assert(cache.weight() == 90);
+}
+
+void testCustomWeigherFunctor() {
+    struct Fixed {
+        size_t operator()(const int&, const int&) const { return 8; }
+    };
+    WeightedLruCache<int, int, Fixed> cache(32, Fixed{});
+    for (int i = 0; i < 10; ++i) {
+        cache.put(i, i);
+    }
+    assert(cache.size() == 4);
+    assert(cache.weight() == 32);
+    assert(cache.evictionCount() == 6);
+}
+
+int main() {
+    test("Tracks Weight", testTracksWeight);
+    test("Evicts As Many As Needed", testEvictsAsManyAsNeeded);
+    test("Rejects Oversized Entry", testRejectsOversizedEntry);
+    test("Oversized Update Drops Stale Value", testOversizedUpdateDropsStaleValue);
+    test("Heavier Update Evicts Others", testHeavierUpdateEvictsOthers);
+    test("Custom Weigher Functor", testCustomWeigherFunctor);
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,161 @@
+#ifndef CPP_DATASTRUCTURES_WEIGHTEDLRUCACHE_H
+#define CPP_DATASTRUCTURES_WEIGHTEDLRUCACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief An LRU cache bounded by total weight (e.g. bytes) instead of entry count.
+ *
+ * LruCacheLinkedList caps the number of entries, which is the wrong unit when
+ * values range from bytes to megabytes. Here a user-supplied weigher assigns
+ * each entry a weight, and put evicts from the LRU tail until the new entry
+ * fits in the budget. An entry heavier than the whole budget is rejected.
+ *
+ * Current weight and eviction counters are exposed so caches can be sized by
+ * memory.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The cached value type.
+ * @tparam Weigher Callable as size_t(const Key&, const Value&).
+ */
+template <typename Key, typename Value,
+          typename Weigher = std::function<size_t(const Key&, const Value&)>>
+class WeightedLruCache {
+private:
+    struct CacheEntry {
+        Value value;
+        size_t weight;
+        typename std::list<Key>::iterator list_iterator;
+    };
+
+public:
+    /**
+     * @brief Constructs the cache.
+     * @param maxWeight The total weight budget.
+     * @param weigher Computes the weight of an entry; called once per put.
+     */
+    WeightedLruCache(const size_t maxWeight, Weigher weigher)
+        : _weigher(std::move(weigher)), _maxWeight(maxWeight) {}
+
+    /**
+     * @brief Gets the value associated with a key and marks it most recently used.
+     *
+     * @param key The key to look up.
+     * @return The value associated with the key.
+     * @throws std::out_of_range if the key is not in the cache.
+     */
+    Value get(const Key& key) {
+        auto it = _cache.find(key);
+        if (it == _cache.end()) {
+            throw std::out_of_range("Key not found in cache.");
+        }
+        _orders.splice(_orders.begin(), _orders, it->second.list_iterator);
+        return it->second.value;
+    }
+
+    /**
+     * @brief Inserts or updates a key-value pair, evicting LRU entries until it fits.
+     *
+     * If the entry alone is heavier than the budget it is rejected, and any
+     * existing entry for the key is removed so a stale value is never served.
+     *
+     * @param key The key to insert or update.
+     * @param value The value associated with the key.
+     * @return true if the entry was stored, false if it was rejected.
+     */
+    bool put(const Key& key, const Value& value) {
+        const size_t weight = _weigher(key, value);
+        auto it = _cache.find(key);
+
+        if (weight > _maxWeight) {
+            ++_rejections;
+            if (it != _cache.end()) {
+                _weight -= it->second.weight;
+                _orders.erase(it->second.list_iterator);
+                _cache.erase(it);
+            }
+            return false;
+        }
+
+        if (it != _cache.end()) {
+            // Update in place, then shed tail entries if the new value is heavier.
+            _orders.splice(_orders.begin(), _orders, it->second.list_iterator);
+            _weight = _weight - it->second.weight + weight;
+            it->second.value = value;
+            it->second.weight = weight;
+            evictUntilWithinBudget(0);
+            return true;
+        }
+
+        evictUntilWithinBudget(weight);
+        _orders.emplace_front(key);
+        _cache.insert({key, {value, weight, _orders.begin()}});
+        _weight += weight;
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of entries currently held by the cache.
+     */
+    size_t size() const { return _cache.size(); }
+
+    /**
+     * @brief Returns the summed weight of all cached entries.
+     */
+    size_t weight() const { return _weight; }
+
+    /**
+     * @brief Returns the weight budget.
+     */
+    size_t maxWeight() const { return _maxWeight; }
+
+    /**
+     * @brief Returns how many entries have been evicted to make room.
+     */
+    size_t evictionCount() const { return _evictions; }
+
+    /**
+     * @brief Returns the summed weight of all evicted entries.
+     */
+    size_t evictedWeight() const { return _evictedWeight; }
+
+    /**
+     * @brief Returns how many puts were rejected for exceeding the budget on their own.
+     */
+    size_t rejectionCount() const { return _rejections; }
+
+private:
+    // Evicts from the tail until `incoming` more weight fits in the budget.
+    // The most recent entry is never evicted by an update of itself, since
+    // its weight alone is known to fit.
+    void evictUntilWithinBudget(const size_t incoming) {
+        while (!_orders.empty() && _weight + incoming > _maxWeight) {
+            auto it = _cache.find(_orders.back());
+            _weight -= it->second.weight;
+            _evictedWeight += it->second.weight;
+            ++_evictions;
+            _cache.erase(it);
+            _orders.pop_back();
+        }
+    }
+
+    // Keys in order of usage, most recent at the front.
+    std::list<Key> _orders;
+
+    // Key to value, weight and position in _orders.
+    std::unordered_map<Key, CacheEntry> _cache;
+
+    Weigher _weigher;
+    size_t _maxWeight;
+    size_t _weight = 0;
+    size_t _evictions = 0;
+    size_t _evictedWeight = 0;
+    size_t _rejections = 0;
+};
+
+#endif //CPP_DATASTRUCTURES_WEIGHTEDLRUCACHE_H
@@ -0,0 +1,170 @@
+#ifndef CPP_DATASTRUCTURES_ASYNCQUEUE_H
+#define CPP_DATASTRUCTURES_ASYNCQUEUE_H
+
+#include "CoroutineExecutor.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief A bounded FIFO queue for coroutines: co_await queue.push(value)
+ * suspends while the queue is full and co_await queue.pop() while it is
+ * empty, without blocking the thread the coroutine runs on.
+ *
+ * Suspended pushers and poppers wait in FIFO lists inside the queue, linked
+ * through their awaiters, so waiting allocates nothing. A push that finds a
+ * popper waiting hands the value straight to it, and a pop that makes room
+ * moves the first waiting pusher's value into the buffer; either way the
+ * woken coroutine is resumed on the executor, never inline, so a chain of
+ * handoffs cannot grow the stack.
+ *
+ * A capacity of 0 makes every push a rendezvous with a pop.
+ *
+ * @tparam T The element type; must be move constructible.
+ */
+template <typename T>
+class AsyncQueue {
+private:
+    template <typename Awaiter>
+    class WaitList {
+    public:
+        void pushBack(Awaiter* waiter) {
+            waiter->_next = nullptr;
+            if (_tail) {
+                _tail->_next = waiter;
+            } else {
+                _head = waiter;
+            }
+            _tail = waiter;
+        }
+
+        Awaiter* popFront() {
+            Awaiter* waiter = _head;
+            if (waiter) {
+                _head = waiter->_next;
+                if (!_head) {
+                    _tail = nullptr;
+                }
+            }
+            return waiter;
+        }
+
+    private:
+        Awaiter* _head = nullptr;
+        Awaiter* _tail = nullptr;
+    };
+
+public:
+    class PushAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(const std::coroutine_handle<> handle) {
+            std::unique_lock<std::mutex> lock(_queue._mutex);
+            if (PopAwaiter* popper = _queue._poppers.popFront()) {
+                popper->_value.emplace(std::move(_value));
+                lock.unlock();
+                _queue._executor.post(popper->_handle);
+                return false;
+            }
+            if (_queue._items.size() < _queue._capacity) {
+                _queue._items.push_back(std::move(_value));
+                return false;
+            }
+            _handle = handle;
+            _queue._pushers.pushBack(this);
+            return true;
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        friend class AsyncQueue;
+        friend class WaitList<PushAwaiter>;
+
+        PushAwaiter(AsyncQueue& queue, T value) : _queue(queue), _value(std::move(value)) {}
+
+        AsyncQueue& _queue;
+        T _value;
+        std::coroutine_handle<> _handle;
+        PushAwaiter* _next = nullptr;
+    };
+
+    class PopAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(const std::coroutine_handle<> handle) {
+            std::unique_lock<std::mutex> lock(_queue._mutex);
+            if (!_queue._items.empty()) {
+                _value.emplace(std::move(_queue._items.front()));
+                _queue._items.pop_front();
+                if (PushAwaiter* pusher = _queue._pushers.popFront()) {
+                    _queue._items.push_back(std::move(pusher->_value));
+                    lock.unlock();
+                    _queue._executor.post(pusher->_handle);
+                }
+                return false;
+            }
+            // Only with capacity 0 can a pusher wait while the buffer is empty.
+            if (PushAwaiter* pusher = _queue._pushers.popFront()) {
+                _value.emplace(std::move(pusher->_value));
+                lock.unlock();
+                _queue._executor.post(pusher->_handle);
+                return false;
+            }
+            _handle = handle;
+            _queue._poppers.pushBack(this);
+            return true;
+        }
+
+        T await_resume() { return std::move(*_value); }
+
+    private:
+        friend class AsyncQueue;
+        friend class WaitList<PopAwaiter>;
+
+        explicit PopAwaiter(AsyncQueue& queue) : _queue(queue) {}
+
+        AsyncQueue& _queue;
+        std::optional<T> _value;
+        std::coroutine_handle<> _handle;
+        PopAwaiter* _next = nullptr;
+    };
+
+    /**
+     * @param executor Where suspended pushers and poppers are resumed.
+     * @param capacity How many elements the queue buffers.
+     */
+    AsyncQueue(CoroutineExecutor& executor, const size_t capacity) : _executor(executor), _capacity(capacity) {}
+
+    AsyncQueue(const AsyncQueue&) = delete;
+    AsyncQueue& operator=(const AsyncQueue&) = delete;
+
+    /**
+     * @brief Returns an awaitable that enqueues value, suspending while the
+     * queue is full.
+     */
+    [[nodiscard]] PushAwaiter push(T value) { return PushAwaiter(*this, std::move(value)); }
+
+    /**
+     * @brief Returns an awaitable that dequeues the oldest element,
+     * suspending while the queue is empty.
+     */
+    [[nodiscard]] PopAwaiter pop() { return PopAwaiter(*this); }
+
+private:
+    CoroutineExecutor& _executor;
+    const size_t _capacity;
+
+    std::mutex _mutex;
+    std::deque<T> _items;
+    WaitList<PushAwaiter> _pushers;
+    WaitList<PopAwaiter> _poppers;
+};
+
+#endif //CPP_DATASTRUCTURES_ASYNCQUEUE_H
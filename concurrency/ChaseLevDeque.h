@@ -0,0 +1,150 @@
+#ifndef CPP_DATASTRUCTURES_CHASELEVDEQUE_H
+#define CPP_DATASTRUCTURES_CHASELEVDEQUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief The Chase–Lev work-stealing deque (SPAA '05).
+ *
+ * One owner thread pushes and pops at the bottom like a stack, which keeps
+ * recently forked work hot in its cache; any other thread may steal from the
+ * top, taking the oldest (usually largest) piece of work. The owner's push
+ * and pop touch only its own cursor except when the deque is about to become
+ * empty, where a CAS on top settles the race with thieves.
+ *
+ * The orderings follow Lê et al. (PPoPP '13), except that the two
+ * seq_cst fences are folded into seq_cst accesses to top and bottom. On x86
+ * this costs the same (one locked instruction in pop and steal) and it lets
+ * ThreadSanitizer check the deque, since it does not model fences.
+ *
+ * The ring grows by doubling when full. Old rings may still be read by a
+ * thief that loaded the pointer before the swap, so they are kept until the
+ * deque is destroyed; with doubling this at most doubles the memory used.
+ *
+ * @tparam T The element type; must be trivially copyable (typically a pointer).
+ */
+template <typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "ChaseLevDeque elements must be trivially copyable");
+
+private:
+    struct Ring {
+        explicit Ring(const int64_t capacity) : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+        T get(const int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(const int64_t i, const T value) { slots[i & mask].store(value, std::memory_order_relaxed); }
+        int64_t capacity() const { return mask + 1; }
+
+        const int64_t mask;
+        const std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+public:
+    /**
+     * @brief Constructs an empty deque.
+     * @param capacity Initial ring size; rounded up to a power of two.
+     */
+    explicit ChaseLevDeque(const size_t capacity = 256) {
+        _rings.push_back(std::make_unique<Ring>(static_cast<int64_t>(std::bit_ceil(std::max<size_t>(capacity, 2)))));
+        _ring.store(_rings.back().get(), std::memory_order_relaxed);
+    }
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    /**
+     * @brief Pushes an element at the bottom. Owner only.
+     */
+    void push(const T value) {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_acquire);
+        Ring* ring = _ring.load(std::memory_order_relaxed);
+        if (b - t > ring->capacity() - 1) {
+            ring = grow(ring, t, b);
+        }
+        ring->put(b, value);
+        _bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pops the most recently pushed element. Owner only.
+     * @return The element, or std::nullopt if the deque is empty.
+     */
+    std::optional<T> pop() {
+        const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        Ring* ring = _ring.load(std::memory_order_relaxed);
+        _bottom.exchange(b, std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_seq_cst);
+
+        if (t > b) {
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        const T value = ring->get(b);
+        if (t == b) {
+            // Last element: race the thieves for it.
+            const bool won = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) {
+                return std::nullopt;
+            }
+        }
+        return value;
+    }
+
+    /**
+     * @brief Steals the oldest element. Safe from any thread.
+     * @return The element, or std::nullopt if the deque was empty or another
+     *         thread won the race for the element.
+     */
+    std::optional<T> steal() {
+        int64_t t = _top.load(std::memory_order_seq_cst);
+        const int64_t b = _bottom.load(std::memory_order_seq_cst);
+        if (t >= b) {
+            return std::nullopt;
+        }
+        const T value = _ring.load(std::memory_order_acquire)->get(t);
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    /**
+     * @brief Returns whether the deque looked empty; may be stale by the time
+     * it returns.
+     */
+    bool empty() const {
+        return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+    }
+
+private:
+    Ring* grow(Ring* old, const int64_t t, const int64_t b) {
+        auto bigger = std::make_unique<Ring>(old->capacity() * 2);
+        for (int64_t i = t; i < b; ++i) {
+            bigger->put(i, old->get(i));
+        }
+        Ring* ring = bigger.get();
+        _rings.push_back(std::move(bigger));
+        _ring.store(ring, std::memory_order_release);
+        return ring;
+    }
+
+    alignas(64) std::atomic<int64_t> _top{0};
+    alignas(64) std::atomic<int64_t> _bottom{0};
+    std::atomic<Ring*> _ring{nullptr};
+
+    // Every ring ever used, current last; owned by the owner thread.
+    std::vector<std::unique_ptr<Ring>> _rings;
+};
+
+#endif //CPP_DATASTRUCTURES_CHASELEVDEQUE_H
@@ -0,0 +1,46 @@
+#ifndef CPP_DATASTRUCTURES_CONDVARQUEUE_H
+#define CPP_DATASTRUCTURES_CONDVARQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+/**
+ * @brief The bounded buffer from ConsumerProducerProblem.cpp as a reusable
+ * class: one std::queue behind one mutex and one condition variable.
+ *
+ * It serves as the baseline in the queue benchmarks. notify_all is used
+ * because with several producers and consumers a single notify_one can wake
+ * the wrong side.
+ */
+template <typename T>
+class CondvarQueue {
+public:
+    explicit CondvarQueue(const size_t capacity) : _capacity(capacity) {}
+
+    void push(T value) {
+        std::unique_lock<std::mutex> lock(_mtx);
+        _cond_var.wait(lock, [this] { return _buffer.size() < _capacity; });
+        _buffer.push(std::move(value));
+        _cond_var.notify_all();
+    }
+
+    T pop() {
+        std::unique_lock<std::mutex> lock(_mtx);
+        _cond_var.wait(lock, [this] { return !_buffer.empty(); });
+        T value = std::move(_buffer.front());
+        _buffer.pop();
+        _cond_var.notify_all();
+        return value;
+    }
+
+private:
+    std::mutex _mtx;
+    std::condition_variable _cond_var;
+    std::queue<T> _buffer;
+    size_t _capacity;
+};
+
+#endif //CPP_DATASTRUCTURES_CONDVARQUEUE_H
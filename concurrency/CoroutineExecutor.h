@@ -0,0 +1,77 @@
+#ifndef CPP_DATASTRUCTURES_COROUTINEEXECUTOR_H
+#define CPP_DATASTRUCTURES_COROUTINEEXECUTOR_H
+
+#include "Task.h"
+#include "WorkStealingPool.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @brief Resumes coroutines on a WorkStealingPool.
+ *
+ * co_await executor.schedule() suspends the calling coroutine and resumes it
+ * on a pool worker; everything after it runs on the pool. A coroutine that
+ * schedules itself from a worker lands on that worker's own deque, so a
+ * fan-out started on the pool stays local until idle workers steal it.
+ *
+ * Resuming a coroutine is one post to the pool, with no future and no
+ * result slot. Destroying the executor runs every coroutine already
+ * scheduled, then joins the workers; coroutines still suspended on something
+ * else at that point are never resumed.
+ */
+class CoroutineExecutor {
+public:
+    /**
+     * @param threads Number of workers; 0 means one per hardware thread.
+     */
+    explicit CoroutineExecutor(const size_t threads = 0) : _pool(threads) {}
+
+    CoroutineExecutor(const CoroutineExecutor&) = delete;
+    CoroutineExecutor& operator=(const CoroutineExecutor&) = delete;
+
+    /**
+     * @brief Returns an awaitable that moves the awaiting coroutine onto the
+     * pool.
+     */
+    auto schedule() noexcept {
+        struct ScheduleAwaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(const std::coroutine_handle<> handle) const { executor.post(handle); }
+            void await_resume() const noexcept {}
+
+            CoroutineExecutor& executor;
+        };
+        return ScheduleAwaiter{*this};
+    }
+
+    /**
+     * @brief Resumes a suspended coroutine on the pool.
+     */
+    void post(const std::coroutine_handle<> handle) {
+        _pool.post([handle] { handle.resume(); });
+    }
+
+    /**
+     * @brief Runs task on the pool without waiting for it. The executor owns
+     * the task until it finishes; an exception escaping it calls
+     * std::terminate, as on a std::thread.
+     */
+    void spawn(Task<void> task) { runSpawned(*this, std::move(task)); }
+
+    /**
+     * @brief Returns the number of worker threads.
+     */
+    size_t size() const { return _pool.size(); }
+
+private:
+    static task_detail::Detached runSpawned(CoroutineExecutor& executor, Task<void> task) {
+        co_await executor.schedule();
+        co_await std::move(task);
+    }
+
+    WorkStealingPool _pool;
+};
+
+#endif //CPP_DATASTRUCTURES_COROUTINEEXECUTOR_H
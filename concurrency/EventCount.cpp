@@ -0,0 +1,156 @@
+#include "EventCount.h"
+#include "MpmcRingQueue.h"
+#include "CondvarQueue.h"
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testReadyConditionReturnsAtOnce() {
+    EventCount events;
+    int calls = 0;
+    events.await([&calls] { return ++calls == 1; });
+    assert(calls == 1);
+    // Nobody is parked, so these must not block or fail.
+    events.notifyOne();
+    events.notifyAll();
+}
+
+// Two threads hand a turn back and forth; a single lost wakeup would hang.
+void testPingPongLosesNoWakeups() {
+    constexpr int rounds = 100000;
+    std::atomic<int> turn{0};
+    EventCount events;
+    std::thread other([&] {
+        for (int i = 0; i < rounds; ++i) {
+            events.await([&] { return turn.load(std::memory_order_acquire) % 2 == 1; });
+            turn.fetch_add(1, std::memory_order_release);
+            events.notifyAll();
+        }
+    });
+    for (int i = 0; i < rounds; ++i) {
+        events.await([&] { return turn.load(std::memory_order_acquire) % 2 == 0; });
+        turn.fetch_add(1, std::memory_order_release);
+        events.notifyAll();
+    }
+    other.join();
+    assert(turn.load() == 2 * rounds);
+}
+
+void testNotifyAllWakesEveryWaiter() {
+    std::atomic<bool> open{false};
+    std::atomic<int> through{0};
+    EventCount events;
+    std::vector<std::thread> waiters;
+    for (int i = 0; i < 8; ++i) {
+        waiters.emplace_back([&] {
+            events.await([&] { return open.load(std::memory_order_acquire); });
+            ++through;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    open.store(true, std::memory_order_release);
+    events.notifyAll();
+    for (auto& t : waiters) {
+        t.join();
+    }
+    assert(through == 8);
+}
+
+// A two-slot queue keeps both producers and consumers parking all the time.
+void testBlockingQueueParksBothSides() {
+    constexpr int producers = 3;
+    constexpr int consumers = 3;
+    constexpr int perProducer = 20000;
+    MpmcRingQueue<int> queue(2);
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue] {
+            for (int i = 1; i <= perProducer; ++i) {
+                queue.push(i);
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&queue, &sum] {
+            long long local = 0;
+            for (int i = 0; i < perProducer; ++i) {
+                local += queue.pop();
+            }
+            sum += local;
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    assert(sum == static_cast<long long>(producers) * perProducer * (perProducer + 1) / 2);
+}
+
+int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Light load: the producer sends a timestamp every so often, so the consumer
+// is usually asleep when it arrives. Returns the sorted push-to-pop delays.
+template <typename Queue>
+std::vector<int64_t> handoffLatencies(const int items, const std::chrono::microseconds gap) {
+    Queue queue(64);
+    std::vector<int64_t> latencies;
+    latencies.reserve(items);
+    std::thread consumer([&queue, &latencies, items] {
+        for (int i = 0; i < items; ++i) {
+            const int64_t sent = queue.pop();
+            latencies.push_back(nowNanos() - sent);
+        }
+    });
+    for (int i = 0; i < items; ++i) {
+        std::this_thread::sleep_for(gap);
+        queue.push(nowNanos());
+    }
+    consumer.join();
+    std::sort(latencies.begin(), latencies.end());
+    return latencies;
+}
+
+void benchmarkHandoffLatency() {
+    constexpr int items = 20000;
+    std::cout << "\nPush-to-pop latency in microseconds, one item every ~50us ("
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    std::cout << "queue\t\t\tp50\tp99\tp99.9" << std::endl;
+    const auto report = [](const std::string& name, const std::vector<int64_t>& sorted) {
+        const auto at = [&sorted](const double q) { return sorted[static_cast<size_t>(q * (sorted.size() - 1))] / 1e3; };
+        std::cout << name << "\t" << at(0.5) << "\t" << at(0.99) << "\t" << at(0.999) << std::endl;
+    };
+    report("mutex+condvar\t", handoffLatencies<CondvarQueue<int64_t>>(items, std::chrono::microseconds(50)));
+    report("MPMC + EventCount", handoffLatencies<MpmcRingQueue<int64_t>>(items, std::chrono::microseconds(50)));
+}
+
+int main() {
+    test("Ready Condition Returns At Once", testReadyConditionReturnsAtOnce);
+    test("Ping Pong Loses No Wakeups", testPingPongLosesNoWakeups);
+    test("Notify All Wakes Every Waiter", testNotifyAllWakesEveryWaiter);
+    test("Blocking Queue Parks Both Sides", testBlockingQueueParksBothSides);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkHandoffLatency();
+    return 0;
+}
@@ -0,0 +1,124 @@
+#ifndef CPP_DATASTRUCTURES_EVENTCOUNT_H
+#define CPP_DATASTRUCTURES_EVENTCOUNT_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+/**
+ * @brief Tells the CPU we are in a spin loop (PAUSE on x86, YIELD on ARM):
+ * saves power and avoids a pipeline flush when the loop exits.
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief Lets threads wait for a condition on lock-free state without a
+ * mutex: waiters spin briefly and then park on a futex with C++20
+ * atomic::wait, and wakers only make a syscall when someone is parked.
+ *
+ * A condition variable needs its mutex on both sides, so every handoff
+ * through one costs the waker a lock and usually a futex call, even when
+ * the waiter has not gone to sleep yet. Here the waker publishes its change
+ * to the lock-free structure first and then calls notifyOne or notifyAll,
+ * which cost a fence and one load unless a thread is parked.
+ *
+ * Waiting is split so that no wakeup is lost between checking the condition
+ * and parking:
+ *
+ * @code
+ *   events.await([&] { return queue.try_pop(out); });
+ * @endcode
+ *
+ * await registers as a waiter and re-checks the condition before parking. A
+ * waker whose change lands after that check will see the waiter count and
+ * bump the epoch, so the park returns at once.
+ *
+ * Spinning only pays when the waker can run at the same time, so on a
+ * single hardware thread await skips straight to parking.
+ */
+class EventCount {
+public:
+    EventCount() = default;
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+
+    /**
+     * @brief Returns once ready() returns true, spinning and then parking
+     * between checks. ready() may have side effects (such as a try_pop) and
+     * is called until it succeeds.
+     */
+    template <typename Ready>
+    void await(Ready&& ready) {
+        for (unsigned spin = 0; spin < spinLimit(); ++spin) {
+            if (ready()) {
+                return;
+            }
+            cpuRelax();
+        }
+        while (!ready()) {
+            const uint32_t epoch = _epoch.load(std::memory_order_acquire);
+            // Pairs with the fence in notify: either the waker sees this
+            // registration, or the re-check below sees the waker's change.
+            _waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (ready()) {
+                // The registration is left behind; it costs at most one
+                // needless wake later, which is cheaper than tracking it.
+                return;
+            }
+            _epoch.wait(epoch, std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Wakes one parked waiter, if any. Call after publishing the
+     * change the waiter is waiting for.
+     */
+    void notifyOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t waiters = _waiters.load(std::memory_order_relaxed);
+        while (waiters != 0) {
+            if (_waiters.compare_exchange_weak(waiters, waiters - 1, std::memory_order_relaxed)) {
+                _epoch.fetch_add(1, std::memory_order_release);
+                _epoch.notify_one();
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Wakes every parked waiter. Call after publishing the change.
+     */
+    void notifyAll() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_relaxed) != 0 && _waiters.exchange(0, std::memory_order_relaxed) != 0) {
+            _epoch.fetch_add(1, std::memory_order_release);
+            _epoch.notify_all();
+        }
+    }
+
+private:
+    // Between one and ten microseconds depending on the CPU's PAUSE latency:
+    // enough to catch a handoff from a peer that is running, and about what a
+    // futex sleep and wake would cost anyway.
+    static constexpr unsigned kSpins = 256;
+
+    static unsigned spinLimit() {
+        static const unsigned limit = std::thread::hardware_concurrency() > 1 ? kSpins : 0;
+        return limit;
+    }
+
+    // Waiters park until _epoch changes. _waiters counts registrations no
+    // waker has claimed yet: each wake claims one (or, for notifyAll, all),
+    // so once the parked thread has been woken, further notifies before it
+    // runs again see zero and skip the syscall.
+    std::atomic<uint32_t> _epoch{0};
+    std::atomic<uint32_t> _waiters{0};
+};
+
+#endif //CPP_DATASTRUCTURES_EVENTCOUNT_H
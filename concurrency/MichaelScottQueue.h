@@ -0,0 +1,125 @@
+#ifndef CPP_DATASTRUCTURES_MICHAELSCOTTQUEUE_H
+#define CPP_DATASTRUCTURES_MICHAELSCOTTQUEUE_H
+
+#include "Reclamation.h"
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief An unbounded lock-free FIFO queue (Michael and Scott, PODC '96).
+ *
+ * A linked list with a dummy node at the front: head points at the dummy and
+ * the first element lives in the node after it. A push links a node after
+ * the last one with a CAS and then swings tail. A pop swings head to the
+ * next node, which becomes the new dummy, and retires the old one. A thread
+ * that finds tail lagging behind the real last node helps move it on before
+ * retrying, so no operation waits for another thread.
+ *
+ * Tail never points behind head: pop helps tail along before it moves head
+ * past it. So a node reachable from tail is never retired.
+ *
+ * @tparam T The element type; must be move constructible and move assignable.
+ * @tparam Reclaimer reclamation::Epoch or reclamation::HazardPointers.
+ */
+template <typename T, typename Reclaimer = reclamation::Epoch>
+class MichaelScottQueue {
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+
+        // Empty in the dummy; moved out when the node becomes the dummy.
+        std::optional<T> value;
+        std::atomic<Node*> next{nullptr};
+    };
+
+public:
+    MichaelScottQueue() {
+        auto* dummy = new Node;
+        _head.store(dummy, std::memory_order_relaxed);
+        _tail.store(dummy, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Deletes the remaining nodes. No other thread may be using the
+     * queue.
+     */
+    ~MichaelScottQueue() {
+        Node* node = _head.load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            delete std::exchange(node, node->next.load(std::memory_order_relaxed));
+        }
+    }
+
+    MichaelScottQueue(const MichaelScottQueue&) = delete;
+    MichaelScottQueue& operator=(const MichaelScottQueue&) = delete;
+
+    void push(T value) {
+        auto* node = new Node(std::move(value));
+        typename Reclaimer::Guard guard;
+        while (true) {
+            Node* tail = guard.protect(_tail, 0);
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (tail != _tail.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (next != nullptr) {
+                // Tail is lagging: help the other push finish.
+                _tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if (tail->next.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed)) {
+                _tail.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Pops the oldest element.
+     * @param out Receives the element.
+     * @return true if an element was popped; false if the queue was empty.
+     */
+    bool try_pop(T& out) {
+        typename Reclaimer::Guard guard;
+        while (true) {
+            Node* head = guard.protect(_head, 0);
+            Node* next = guard.protect(head->next, 1);
+            if (head != _head.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (next == nullptr) {
+                return false;
+            }
+            Node* tail = _tail.load(std::memory_order_acquire);
+            if (head == tail) {
+                _tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if (_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                out = std::move(*next->value);
+                next->value.reset();
+                guard.retire(head);
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns whether the queue looked empty; may be stale by the time
+     * it returns.
+     */
+    bool empty() const {
+        typename Reclaimer::Guard guard;
+        return guard.protect(_head, 0)->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    // Each cursor on its own cache line.
+    alignas(64) std::atomic<Node*> _head{nullptr};
+    alignas(64) std::atomic<Node*> _tail{nullptr};
+};
+
+#endif //CPP_DATASTRUCTURES_MICHAELSCOTTQUEUE_H
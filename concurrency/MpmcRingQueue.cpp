@@ -0,0 +1,254 @@
+#include "MpmcRingQueue.h"
+#include "CondvarQueue.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testFifoAndBounds() {
+    MpmcRingQueue<int> queue(3);
+    assert(queue.capacity() == 4);
+    int out = 0;
+    assert(!queue.try_pop(out));
+    for (int i = 0; i < 4; ++i) {
+        assert(queue.try_push(i));
+    }
+    assert(!queue.try_push(4));
+    for (int i = 0; i < 4; ++i) {
+        assert(queue.try_pop(out) && out == i);
+    }
+    assert(!queue.try_pop(out));
+
+    // Wrap around the ring a few times.
+    for (int i = 0; i < 100; ++i) {
+        queue.push(i);
+        assert(queue.pop() == i);
+    }
+}
+
+void testMoveOnlyAndCleanup() {
+    auto tracker = std::make_shared<int>(0);
+    {
+        MpmcRingQueue<std::unique_ptr<std::shared_ptr<int>>> queue(8);
+        for (int i = 0; i < 5; ++i) {
+            queue.push(std::make_unique<std::shared_ptr<int>>(tracker));
+        }
+        auto first = queue.pop();
+        assert(*first == tracker);
+        assert(tracker.use_count() == 6);
+    }
+    // Elements still queued were destroyed with the queue.
+    assert(tracker.use_count() == 1);
+}
+
+// Copying throws on demand; moving never does.
+struct ThrowingCopy {
+    static inline bool failCopies = false;
+    int value = 0;
+
+    ThrowingCopy() = default;
+    explicit ThrowingCopy(const int v) : value(v) {}
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (failCopies) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    ThrowingCopy(ThrowingCopy&&) noexcept = default;
+    ThrowingCopy& operator=(ThrowingCopy&&) noexcept = default;
+};
+
+void testThrowingCopyLeavesQueueUsable() {
+    MpmcRingQueue<ThrowingCopy> queue(4);
+    const ThrowingCopy item(7);
+    ThrowingCopy::failCopies = true;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        bool exception_caught = false;
+        try {
+            if (attempt == 0) {
+                queue.push(item);
+            } else {
+                queue.try_push(item);
+            }
+        } catch (const std::runtime_error&) {
+            exception_caught = true;
+        }
+        assert(exception_caught);
+    }
+    ThrowingCopy::failCopies = false;
+    assert(queue.size() == 0);
+
+    // No cell was left claimed and empty, so the next element comes straight through.
+    queue.push(item);
+    assert(queue.try_push(ThrowingCopy(8)));
+    ThrowingCopy out;
+    assert(queue.try_pop(out) && out.value == 7);
+    assert(queue.pop().value == 8);
+}
+
+// Moving into an existing object throws on demand; constructing never does.
+struct ThrowingMoveAssign {
+    static inline bool failAssigns = false;
+    int value = 0;
+
+    ThrowingMoveAssign() = default;
+    explicit ThrowingMoveAssign(const int v) : value(v) {}
+    ThrowingMoveAssign(ThrowingMoveAssign&&) noexcept = default;
+    ThrowingMoveAssign& operator=(ThrowingMoveAssign&& other) {
+        if (failAssigns) {
+            throw std::runtime_error("assignment failed");
+        }
+        value = other.value;
+        return *this;
+    }
+};
+
+void testThrowingMoveAssignLeavesQueueUsable() {
+    MpmcRingQueue<ThrowingMoveAssign> queue(2);
+    assert(queue.try_push(ThrowingMoveAssign(1)));
+    assert(queue.try_push(ThrowingMoveAssign(2)));
+    ThrowingMoveAssign out;
+    ThrowingMoveAssign::failAssigns = true;
+    bool exception_caught = false;
+    try {
+        queue.try_pop(out);
+    } catch (const std::runtime_error&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+    ThrowingMoveAssign::failAssigns = false;
+
+    // The failed pop handed its cell back, so pushing wraps around into it.
+    assert(queue.try_push(ThrowingMoveAssign(3)));
+    assert(!queue.try_push(ThrowingMoveAssign(4)));
+    assert(queue.try_pop(out) && out.value == 2);
+    assert(queue.try_pop(out) && out.value == 3);
+    assert(!queue.try_pop(out));
+}
+
+void testRejectsZeroCapacity() {
+    bool exception_caught = false;
+    try {
+        MpmcRingQueue<int> queue(0);
+    } catch (const std::invalid_argument&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+// Every item arrives exactly once, and each consumer sees each producer's
+// items in the order they were pushed.
+void testConcurrentProducersAndConsumers() {
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int perProducer = 50000;
+    MpmcRingQueue<long long> queue(64);
+    std::atomic<long long> sum{0};
+    std::atomic<int> received{0};
+    std::atomic<bool> ordered{true};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (int i = 0; i < perProducer; ++i) {
+                queue.push(static_cast<long long>(p) * perProducer + i);
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::vector<long long> last(producers, -1);
+            long long item;
+            while (received.load() < producers * perProducer) {
+                if (!queue.try_pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ++received;
+                sum += item;
+                const auto p = static_cast<size_t>(item / perProducer);
+                if (item <= last[p]) ordered = false;
+                last[p] = item;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    const long long n = static_cast<long long>(producers) * perProducer;
+    assert(received == n);
+    assert(sum == n * (n - 1) / 2);
+    assert(ordered);
+}
+
+long long benchmarkSink = 0;
+
+template <typename Queue>
+double itemsPerSecond(const int pairs, const int totalItems) {
+    Queue queue(1024);
+    const int perThread = totalItems / pairs;
+    std::atomic<long long> sink{0};
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < pairs; ++t) {
+        threads.emplace_back([&queue, perThread] {
+            for (int i = 0; i < perThread; ++i) {
+                queue.push(static_cast<long long>(i));
+            }
+        });
+        threads.emplace_back([&queue, &sink, perThread] {
+            long long local = 0;
+            for (int i = 0; i < perThread; ++i) {
+                local += queue.pop();
+            }
+            sink += local;
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink += sink;
+    return perThread * pairs / elapsed.count();
+}
+
+void benchmarkThroughput() {
+    constexpr int totalItems = 2000000;
+    std::cout << "\nMillion items/s through a 1024-slot queue (" << std::thread::hardware_concurrency()
+              << " hardware threads)" << std::endl;
+    std::cout << "producers/consumers\tmutex+condvar\tMPMC ring" << std::endl;
+    for (const int pairs : {1, 2, 4, 8, 16}) {
+        std::cout << pairs << "/" << pairs << "\t\t\t"
+                  << itemsPerSecond<CondvarQueue<long long>>(pairs, totalItems) / 1e6 << "\t\t"
+                  << itemsPerSecond<MpmcRingQueue<long long>>(pairs, totalItems) / 1e6 << std::endl;
+    }
+}
+
+int main() {
+    test("FIFO And Bounds", testFifoAndBounds);
+    test("Move Only And Cleanup", testMoveOnlyAndCleanup);
+    test("Throwing Copy Leaves Queue Usable", testThrowingCopyLeavesQueueUsable);
+    test("Throwing Move Assign Leaves Queue Usable", testThrowingMoveAssignLeavesQueueUsable);
+    test("Rejects Zero Capacity", testRejectsZeroCapacity);
+    test("Concurrent Producers And Consumers", testConcurrentProducersAndConsumers);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkThroughput();
+    return 0;
+}
@@ -0,0 +1,210 @@
+#ifndef CPP_DATASTRUCTURES_MPMCRINGQUEUE_H
+#define CPP_DATASTRUCTURES_MPMCRINGQUEUE_H
+
+#include "EventCount.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief A bounded lock-free multi-producer multi-consumer queue (Vyukov).
+ *
+ * The queue is a power-of-two ring of cells, each carrying a sequence number
+ * that says whose turn the cell is: a producer may fill cell i when its
+ * sequence equals the producer's ticket, and a consumer may empty it when the
+ * sequence equals ticket + 1. Producers and consumers claim tickets with a CAS
+ * on their own cursor, so the only shared writes are one CAS per operation
+ * and the cell itself; there is no lock and no allocation after construction.
+ *
+ * The enqueue and dequeue cursors live on separate cache lines so producers
+ * and consumers do not invalidate each other's cursor.
+ *
+ * The blocking push and pop spin and then park on an EventCount. Every
+ * successful push or pop checks whether anyone is parked on the other side,
+ * which costs one fence and, in the common case, no syscall.
+ *
+ * @tparam T The element type; must be nothrow move constructible, and
+ *         default constructible for pop. Pushing arguments T is built from
+ *         with a constructor that may throw, such as a copy, builds the T
+ *         before a cell is claimed. If assigning the popped element to the
+ *         caller's variable throws, that element is lost but the queue
+ *         stays usable.
+ */
+template <typename T>
+class MpmcRingQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "MpmcRingQueue requires nothrow-movable elements");
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+public:
+    /**
+     * @brief Constructs a queue holding at least capacity elements.
+     * @param capacity The minimum capacity; rounded up to a power of two.
+     * @throws std::invalid_argument if capacity is 0.
+     */
+    explicit MpmcRingQueue(const size_t capacity)
+        : _mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1), _cells(new Cell[_mask + 1]) {
+        if (capacity == 0) {
+            throw std::invalid_argument("MpmcRingQueue capacity must be positive.");
+        }
+        for (size_t i = 0; i <= _mask; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcRingQueue() {
+        const size_t end = _enqueuePos.load(std::memory_order_relaxed);
+        for (size_t pos = _dequeuePos.load(std::memory_order_relaxed); pos != end; ++pos) {
+            _cells[pos & _mask].value()->~T();
+        }
+    }
+
+    MpmcRingQueue(const MpmcRingQueue&) = delete;
+    MpmcRingQueue& operator=(const MpmcRingQueue&) = delete;
+
+    /**
+     * @brief Pushes an element if the queue is not full.
+     *
+     * A claimed cell must be filled, or consumers would wait on it forever,
+     * so when building a T from value can throw, the T is built first and
+     * then moved in. Any exception then leaves the queue unchanged, but an
+     * rvalue value has been consumed even if the queue turns out to be full.
+     *
+     * @return true if the element was pushed; false if the queue was full, in
+     *         which case value is left untouched unless it was converted as
+     *         described above.
+     */
+    template <typename U>
+    bool try_push(U&& value) {
+        if constexpr (std::is_nothrow_constructible_v<T, U&&>) {
+            return tryPushInPlace(std::forward<U>(value));
+        } else {
+            return tryPushInPlace(T(std::forward<U>(value)));
+        }
+    }
+
+    /**
+     * @brief Pops the oldest element if the queue is not empty.
+     * @param out Receives the element.
+     * @return true if an element was popped; false if the queue was empty.
+     */
+    bool try_pop(T& out) {
+        size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[pos & _mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        // Only nothrow moves happen while the cell is claimed; assigning to
+        // out may throw, so it waits until the cell is handed back.
+        T* value = cell->value();
+        T element(std::move(*value));
+        value->~T();
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+        _notFull.notifyOne();
+        out = std::move(element);
+        return true;
+    }
+
+    /**
+     * @brief Pushes an element, waiting while the queue is full.
+     */
+    template <typename U>
+    void push(U&& value) {
+        if constexpr (std::is_nothrow_constructible_v<T, U&&>) {
+            _notFull.await([&] { return tryPushInPlace(std::forward<U>(value)); });
+        } else {
+            // Built once, outside the retry loop.
+            T element(std::forward<U>(value));
+            _notFull.await([&] { return tryPushInPlace(std::move(element)); });
+        }
+    }
+
+    /**
+     * @brief Pops the oldest element, waiting while the queue is empty.
+     */
+    T pop() {
+        T out;
+        _notEmpty.await([&] { return try_pop(out); });
+        return out;
+    }
+
+    /**
+     * @brief Returns the number of elements the queue can hold.
+     */
+    size_t capacity() const { return _mask + 1; }
+
+    /**
+     * @brief Returns roughly how many elements are queued, counting pushes
+     * and pops still in progress; exact only when no thread is using the
+     * queue. Meant for monitoring.
+     */
+    size_t size() const {
+        const size_t dequeued = _dequeuePos.load(std::memory_order_relaxed);
+        const size_t enqueued = _enqueuePos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? std::min(enqueued - dequeued, capacity()) : 0;
+    }
+
+private:
+    // The body of try_push, for arguments T can be built from without throwing.
+    template <typename U>
+    bool tryPushInPlace(U&& value) {
+        static_assert(std::is_nothrow_constructible_v<T, U&&>, "A claimed cell must be filled without throwing");
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[pos & _mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (cell->storage) T(std::forward<U>(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        _notEmpty.notifyOne();
+        return true;
+    }
+
+    const size_t _mask;
+    const std::unique_ptr<Cell[]> _cells;
+
+    // Each cursor on its own cache line.
+    alignas(64) std::atomic<size_t> _enqueuePos{0};
+    alignas(64) std::atomic<size_t> _dequeuePos{0};
+
+    // Written only when a thread parks, so read-mostly.
+    alignas(64) EventCount _notEmpty;
+    EventCount _notFull;
+};
+
+#endif //CPP_DATASTRUCTURES_MPMCRINGQUEUE_H
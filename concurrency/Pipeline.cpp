@@ -0,0 +1,303 @@
+#include "Pipeline.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+// Returns 0, 1, ..., n - 1, then std::nullopt.
+std::function<std::optional<int>()> counting(const int n) {
+    return [i = 0, n]() mutable -> std::optional<int> {
+        if (i == n) {
+            return std::nullopt;
+        }
+        return i++;
+    };
+}
+
+void testEveryItemProcessedOnce() {
+    constexpr int n = 100000;
+    std::atomic<int64_t> sum{0};
+    std::atomic<int> count{0};
+    auto pipeline = PipelineBuilder<int>(64)
+        .stage("double", 3, StageOrder::Unordered, [](const int x) { return int64_t{x} * 2; })
+        .stage("increment", 2, StageOrder::Unordered, [](const int64_t x) { return x + 1; })
+        .sink("sum", 2, StageOrder::Unordered, [&](const int64_t x) {
+            sum += x;
+            ++count;
+        });
+    const PipelineStats stats = pipeline.run(counting(n));
+    assert(count == n);
+    assert(sum == int64_t{n} * (n - 1) + n);
+    assert(stats.stages.size() == 3);
+    for (const StageStats& stage : stats.stages) {
+        assert(stage.items == static_cast<uint64_t>(n));
+    }
+
+    // A pipeline can be run again.
+    sum = 0;
+    count = 0;
+    pipeline.run(counting(10));
+    assert(count == 10 && sum == 100);
+}
+
+void testOrderedStagesKeepSourceOrder() {
+    constexpr int n = 20000;
+    std::vector<int> seen;
+    auto pipeline = PipelineBuilder<int>(16)
+        .stage("jitter", 4, StageOrder::Ordered, [](const int x) {
+            // Make later items overtake earlier ones.
+            if (x % 97 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            return x;
+        })
+        .stage("shuffle", 4, StageOrder::Unordered, [](const int x) {
+            if (x % 89 == 0) {
+                std::this_thread::yield();
+            }
+            return x;
+        })
+        .sink("collect", 3, StageOrder::Ordered, [&](const int x) { seen.push_back(x); });
+    pipeline.run(counting(n));
+    assert(seen.size() == static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        assert(seen[i] == i);
+    }
+}
+
+struct CopyCounted {
+    static inline std::atomic<int> copies{0};
+    int value = 0;
+
+    explicit CopyCounted(const int v) : value(v) {}
+    CopyCounted(const CopyCounted& other) : value(other.value) { ++copies; }
+    CopyCounted(CopyCounted&& other) noexcept = default;
+    CopyCounted& operator=(const CopyCounted& other) {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    CopyCounted& operator=(CopyCounted&&) noexcept = default;
+};
+
+void testItemsAreMovedNotCopied() {
+    constexpr int n = 10000;
+    std::atomic<int64_t> sum{0};
+    auto boxes = PipelineBuilder<int>(32)
+        .stage("box", 2, StageOrder::Unordered, [](const int x) { return std::make_unique<int>(x); })
+        .stage("grow", 2, StageOrder::Ordered, [](std::unique_ptr<int> p) {
+            *p += 1;
+            return p;
+        })
+        .sink("unbox", 2, StageOrder::Unordered, [&](std::unique_ptr<int> p) { sum += *p; });
+    boxes.run(counting(n));
+    assert(sum == int64_t{n} * (n - 1) / 2 + n);
+
+    CopyCounted::copies = 0;
+    int64_t ordered = 0;
+    auto counted = PipelineBuilder<int>(32)
+        .stage("make", 2, StageOrder::Unordered, [](const int x) { return CopyCounted(x); })
+        .stage("pass", 3, StageOrder::Ordered, [](CopyCounted c) { return c; })
+        .sink("take", 1, StageOrder::Ordered, [&](CopyCounted c) { ordered += c.value; });
+    counted.run(counting(n));
+    assert(ordered == int64_t{n} * (n - 1) / 2);
+    assert(CopyCounted::copies == 0);
+}
+
+void testBackpressureBoundsItemsInFlight() {
+    constexpr int n = 2000;
+    constexpr size_t capacity = 8;
+    std::atomic<int> produced{0};
+    std::atomic<int> consumed{0};
+    std::atomic<int> maxInFlight{0};
+    auto pipeline = PipelineBuilder<int>(capacity)
+        .stage("fast", 2, StageOrder::Unordered, [](const int x) { return x; })
+        .sink("slow", 1, StageOrder::Unordered, [&](int) {
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+            ++consumed;
+        });
+    auto source = [&, next = counting(n)]() mutable {
+        const int inFlight = produced - consumed;
+        int seen = maxInFlight.load();
+        while (inFlight > seen && !maxInFlight.compare_exchange_weak(seen, inFlight)) {
+        }
+        std::optional<int> item = next();
+        if (item) {
+            ++produced;
+        }
+        return item;
+    };
+    const PipelineStats stats = pipeline.run(source);
+    assert(consumed == n);
+    // Two queues, one item in each of the three workers and one in the
+    // source's hand: the source can never run further ahead than that.
+    assert(maxInFlight <= static_cast<int>(2 * capacity + 3 + 1));
+    assert(stats.bottleneck() == 1);
+    assert(stats.stages[1].maxQueued <= stats.stages[1].queueCapacity);
+}
+
+void testStageExceptionPropagates() {
+    for (const StageOrder order : {StageOrder::Unordered, StageOrder::Ordered}) {
+        std::atomic<int> sunk{0};
+        auto pipeline = PipelineBuilder<int>(4)
+            .stage("validate", 3, order, [](const int x) {
+                if (x == 500) {
+                    throw std::runtime_error("bad record 500");
+                }
+                return x;
+            })
+            .stage("pass", 2, StageOrder::Ordered, [](const int x) { return x; })
+            .sink("count", 2, order, [&](int) { ++sunk; });
+        bool exception_caught = false;
+        try {
+            pipeline.run(counting(100000));
+        } catch (const std::runtime_error& e) {
+            exception_caught = std::string(e.what()) == "bad record 500";
+        }
+        assert(exception_caught);
+        assert(sunk < 100000);
+    }
+
+    // A sink that throws fails the run the same way, and the pipeline can run again after it.
+    for (const StageOrder order : {StageOrder::Unordered, StageOrder::Ordered}) {
+        std::atomic<bool> failOnce{true};
+        std::atomic<int> sunk{0};
+        auto pipeline = PipelineBuilder<int>(4)
+            .stage("pass", 2, order, [](const int x) { return x; })
+            .sink("store", 3, order, [&](const int x) {
+                if (x == 700 && failOnce.exchange(false)) {
+                    throw std::runtime_error("store failed at 700");
+                }
+                ++sunk;
+            });
+        bool sinkException = false;
+        try {
+            pipeline.run(counting(100000));
+        } catch (const std::runtime_error& e) {
+            sinkException = std::string(e.what()) == "store failed at 700";
+        }
+        assert(sinkException);
+        assert(sunk < 100000);
+        sunk = 0;
+        pipeline.run(counting(5000));
+        assert(sunk == 5000);
+    }
+
+    bool exception_caught = false;
+    try {
+        PipelineBuilder<int>().sink("none", 0, StageOrder::Unordered, [](int) {});
+    } catch (const std::invalid_argument&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+struct Record {
+    uint64_t key = 0;
+    uint64_t value = 0;
+};
+
+Record parseRecord(const std::string& line) {
+    Record record;
+    size_t i = 0;
+    for (; line[i] != ','; ++i) {
+        record.key = record.key * 10 + static_cast<uint64_t>(line[i] - '0');
+    }
+    for (++i; i < line.size(); ++i) {
+        record.value = record.value * 10 + static_cast<uint64_t>(line[i] - '0');
+    }
+    return record;
+}
+
+// Stands in for an enrichment step: a few hundred nanoseconds of hashing.
+Record transformRecord(Record record, const int rounds) {
+    uint64_t h = record.value;
+    for (int r = 0; r < rounds; ++r) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 29;
+    }
+    record.value = h & 0xffff;
+    return record;
+}
+
+std::vector<std::string> makeLines(const int n) {
+    std::vector<std::string> lines;
+    lines.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        lines.push_back(std::to_string(i % 1000) + "," + std::to_string(i * 7919 % 100000));
+    }
+    return lines;
+}
+
+uint64_t benchmarkSink = 0;
+
+void benchmarkIngestion() {
+    constexpr int n = 200000;
+    constexpr int rounds = 200;
+    const std::vector<std::string> lines = makeLines(n);
+
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t serialTotal = 0;
+    for (const std::string& line : lines) {
+        serialTotal += transformRecord(parseRecord(line), rounds).value;
+    }
+    const std::chrono::duration<double> serial = std::chrono::steady_clock::now() - start;
+    benchmarkSink += serialTotal;
+
+    std::cout << "\nparse -> transform -> aggregate, " << n << " lines ("
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    std::cout << "single thread, no pipeline: " << static_cast<uint64_t>(n / serial.count()) << " items/s" << std::endl;
+
+    for (const size_t transformWorkers : {1, 4}) {
+        uint64_t total = 0;
+        auto pipeline = PipelineBuilder<std::string>(256)
+            .stage("parse", 1, StageOrder::Unordered, [](std::string line) { return parseRecord(line); })
+            .stage("transform", transformWorkers, StageOrder::Unordered,
+                   [](Record r) { return transformRecord(r, rounds); })
+            .sink("aggregate", 1, StageOrder::Ordered, [&](const Record r) { total += r.value; });
+        size_t next = 0;
+        const PipelineStats stats = pipeline.run([&]() -> std::optional<std::string> {
+            if (next == lines.size()) {
+                return std::nullopt;
+            }
+            return lines[next++];
+        });
+        assert(total == serialTotal);
+        benchmarkSink += total;
+        std::cout << "\n" << transformWorkers << " transform worker(s): "
+                  << static_cast<uint64_t>(n / stats.wallSeconds) << " items/s" << std::endl;
+        stats.print(std::cout);
+    }
+}
+
+int main() {
+    test("Every Item Processed Once", testEveryItemProcessedOnce);
+    test("Ordered Stages Keep Source Order", testOrderedStagesKeepSourceOrder);
+    test("Items Are Moved Not Copied", testItemsAreMovedNotCopied);
+    test("Backpressure Bounds Items In Flight", testBackpressureBoundsItemsInFlight);
+    test("Stage Exception Propagates", testStageExceptionPropagates);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkIngestion();
+    return 0;
+}
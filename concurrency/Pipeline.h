@@ -0,0 +1,605 @@
+#ifndef CPP_DATASTRUCTURES_PIPELINE_H
+#define CPP_DATASTRUCTURES_PIPELINE_H
+
+#include "EventCount.h"
+#include "MpmcRingQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief How a stage orders what it emits.
+ *
+ * Unordered: results go downstream as soon as they are ready.
+ * Ordered: results go downstream in the order the source produced the items,
+ * although the stage's workers still run in parallel. For a sink, the sink
+ * function is called in source order, one item at a time.
+ */
+enum class StageOrder { Unordered, Ordered };
+
+/**
+ * @brief What one stage did during a run.
+ */
+struct StageStats {
+    std::string name;
+    size_t workers = 0;
+    StageOrder order = StageOrder::Unordered;
+    uint64_t items = 0;
+    // Time spent inside the stage function, summed over the workers.
+    double busySeconds = 0;
+    double wallSeconds = 0;
+    // Occupancy of the stage's input queue, sampled during the run.
+    double meanQueued = 0;
+    size_t maxQueued = 0;
+    size_t queueCapacity = 0;
+
+    double itemsPerSecond() const { return wallSeconds > 0 ? static_cast<double>(items) / wallSeconds : 0; }
+
+    /**
+     * @brief The fraction of the workers' time spent in the stage function.
+     */
+    double utilization() const {
+        return wallSeconds > 0 && workers > 0 ? busySeconds / (wallSeconds * static_cast<double>(workers)) : 0;
+    }
+};
+
+/**
+ * @brief Per-stage statistics of one Pipeline run.
+ *
+ * The bottleneck is the stage whose workers are busiest; its input queue
+ * is typically near capacity while the queues after it are nearly empty.
+ */
+struct PipelineStats {
+    double wallSeconds = 0;
+    std::vector<StageStats> stages;
+
+    size_t bottleneck() const {
+        const auto busiest = std::max_element(stages.begin(), stages.end(), [](const auto& a, const auto& b) {
+            return a.utilization() < b.utilization();
+        });
+        return static_cast<size_t>(busiest - stages.begin());
+    }
+
+    void print(std::ostream& out) const {
+        out << "stage\t\tworkers\titems/s\t\tbusy\tqueued (mean/max/capacity)\n";
+        for (size_t i = 0; i < stages.size(); ++i) {
+            const StageStats& s = stages[i];
+            out << std::left << std::setw(16) << s.name << s.workers << "\t" << std::setw(16)
+                << std::fixed << std::setprecision(0) << s.itemsPerSecond() << std::setprecision(0)
+                << s.utilization() * 100 << "%\t" << std::setprecision(1) << s.meanQueued << "/" << s.maxQueued
+                << "/" << s.queueCapacity << (i == bottleneck() ? "\t<- bottleneck" : "") << "\n";
+        }
+        out.unsetf(std::ios::floatfield | std::ios::adjustfield);
+        out << std::setprecision(6);
+    }
+};
+
+namespace pipeline_detail {
+
+// An item in flight with its position in the source order, or an
+// end-of-stream marker for one downstream worker.
+template <typename T>
+struct Envelope {
+    uint64_t seq = 0;
+    std::optional<T> value;
+};
+
+template <typename T>
+using Channel = MpmcRingQueue<Envelope<T>>;
+
+/**
+ * @brief Hands results over in source order. A result that arrives early
+ * waits in a ring slot until the ones before it have been delivered; deliver
+ * runs under the lock, one result at a time, in order.
+ *
+ * The pipeline never has more than liveItems items between the source and
+ * the end of the sink, and the next result due is one of them, so every
+ * result that can arrive is less than liveItems ahead of it and a ring of
+ * that size never overflows. Workers therefore never wait here for an item
+ * that may still be queued behind them.
+ */
+template <typename T>
+class Reorderer {
+public:
+    void reset(const size_t liveItems) {
+        _slots.clear();
+        _slots.resize(liveItems);
+        _next = 0;
+    }
+
+    template <typename Deliver>
+    void submit(const uint64_t seq, T value, Deliver&& deliver) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (seq != _next) {
+            _slots[seq % _slots.size()].emplace(std::move(value));
+            return;
+        }
+        deliver(std::move(value));
+        ++_next;
+        for (auto* slot = &_slots[_next % _slots.size()]; slot->has_value(); slot = &_slots[_next % _slots.size()]) {
+            deliver(std::move(**slot));
+            slot->reset();
+            ++_next;
+        }
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<std::optional<T>> _slots;
+    uint64_t _next = 0;
+};
+
+struct WorkerCounters {
+    uint64_t items = 0;
+    std::chrono::steady_clock::duration busy{};
+
+    template <typename F>
+    decltype(auto) time(F&& f) {
+        struct Stopwatch {
+            ~Stopwatch() { counters.busy += std::chrono::steady_clock::now() - start; }
+            WorkerCounters& counters;
+            std::chrono::steady_clock::time_point start;
+        } stopwatch{*this, std::chrono::steady_clock::now()};
+        ++items;
+        return f();
+    }
+};
+
+/**
+ * @brief State shared by all stages of one run.
+ *
+ * The source takes a token for each item it emits and the item gives it back
+ * when it leaves the pipeline, so at most liveItems items are ever in flight.
+ * After the first failure every stage only drains its input so the run can
+ * end.
+ */
+struct RunState {
+    explicit RunState(const size_t liveItems) : liveItems(liveItems) {}
+
+    void acquire() {
+        _released.await([this] {
+            return _inFlight.load(std::memory_order_acquire) < liveItems || failed.load(std::memory_order_acquire);
+        });
+        _inFlight.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() {
+        _inFlight.fetch_sub(1, std::memory_order_release);
+        _released.notifyOne();
+    }
+
+    void fail(std::exception_ptr e) {
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::move(e);
+            }
+        }
+        failed.store(true, std::memory_order_release);
+        _released.notifyAll();
+    }
+
+    const size_t liveItems;
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+private:
+    std::atomic<size_t> _inFlight{0};
+    EventCount _released;
+};
+
+class StageBase {
+public:
+    virtual ~StageBase() = default;
+    virtual void start(RunState& run) = 0;
+    virtual void join() = 0;
+    virtual size_t queued() const = 0;
+    virtual size_t queueCapacity() const = 0;
+    virtual size_t workers() const = 0;
+    virtual StageStats stats() const = 0;
+};
+
+template <typename Out>
+class Producing {
+public:
+    virtual ~Producing() = default;
+    virtual void connect(Channel<Out>* output, size_t outputWorkers) = 0;
+};
+
+/**
+ * @brief The part of a stage that does not depend on its output: the input
+ * queue, the workers and their counters.
+ */
+template <typename In>
+class StageCore : public StageBase {
+public:
+    StageCore(std::string name, const size_t workers, const StageOrder order, const size_t capacity)
+        : _order(order), _input(capacity), _name(std::move(name)), _workers(workers) {
+        if (workers == 0) {
+            throw std::invalid_argument("A pipeline stage needs at least one worker.");
+        }
+    }
+
+    Channel<In>& input() { return _input; }
+    size_t workers() const override { return _workers; }
+    size_t queueCapacity() const override { return _input.capacity(); }
+
+    void start(RunState& run) override {
+        _run = &run;
+        _running.store(_workers, std::memory_order_relaxed);
+        _items = 0;
+        _busy = {};
+        for (size_t i = 0; i < _workers; ++i) {
+            _threads.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    void join() override {
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+        _threads.clear();
+    }
+
+    size_t queued() const override { return _input.size(); }
+
+    StageStats stats() const override {
+        StageStats s;
+        s.name = _name;
+        s.workers = _workers;
+        s.order = _order;
+        s.items = _items;
+        s.busySeconds = std::chrono::duration<double>(_busy).count();
+        s.queueCapacity = _input.capacity();
+        return s;
+    }
+
+protected:
+    virtual void process(uint64_t seq, In&& value, WorkerCounters& counters) = 0;
+    // Called once, by the last worker to finish.
+    virtual void finish() = 0;
+
+    RunState* _run = nullptr;
+    const StageOrder _order;
+
+private:
+    void workerLoop() {
+        WorkerCounters counters;
+        while (true) {
+            Envelope<In> envelope = _input.pop();
+            if (!envelope.value) {
+                break;
+            }
+            if (_run->failed.load(std::memory_order_acquire)) {
+                _run->release();
+                continue;
+            }
+            try {
+                process(envelope.seq, std::move(*envelope.value), counters);
+            } catch (...) {
+                _run->fail(std::current_exception());
+                _run->release();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(_countersMutex);
+            _items += counters.items;
+            _busy += counters.busy;
+        }
+        if (_running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            finish();
+        }
+    }
+
+    Channel<In> _input;
+    const std::string _name;
+    const size_t _workers;
+    std::vector<std::thread> _threads;
+    std::atomic<size_t> _running{0};
+
+    std::mutex _countersMutex;
+    uint64_t _items = 0;
+    std::chrono::steady_clock::duration _busy{};
+};
+
+template <typename In, typename Out, typename F>
+class TransformStage final : public StageCore<In>, public Producing<Out> {
+public:
+    TransformStage(std::string name, const size_t workers, const StageOrder order, const size_t capacity, F fn)
+        : StageCore<In>(std::move(name), workers, order, capacity), _fn(std::move(fn)) {}
+
+    void connect(Channel<Out>* output, const size_t outputWorkers) override {
+        _output = output;
+        _outputWorkers = outputWorkers;
+    }
+
+    void start(RunState& run) override {
+        _reorderer.reset(run.liveItems);
+        _delivered = 0;
+        StageCore<In>::start(run);
+    }
+
+protected:
+    void process(const uint64_t seq, In&& value, WorkerCounters& counters) override {
+        Out result = counters.time([&] { return _fn(std::move(value)); });
+        if (this->_order == StageOrder::Unordered) {
+            _output->push(Envelope<Out>{seq, std::move(result)});
+            return;
+        }
+        _reorderer.submit(seq, std::move(result), [this](Out&& ready) {
+            _output->push(Envelope<Out>{_delivered++, std::move(ready)});
+        });
+    }
+
+    void finish() override {
+        for (size_t i = 0; i < _outputWorkers; ++i) {
+            _output->push(Envelope<Out>{});
+        }
+    }
+
+private:
+    F _fn;
+    Reorderer<Out> _reorderer;
+    // Only touched inside the reorderer's lock.
+    uint64_t _delivered = 0;
+    Channel<Out>* _output = nullptr;
+    size_t _outputWorkers = 0;
+};
+
+template <typename In, typename F>
+class SinkStage final : public StageCore<In> {
+public:
+    SinkStage(std::string name, const size_t workers, const StageOrder order, const size_t capacity, F fn)
+        : StageCore<In>(std::move(name), workers, order, capacity), _fn(std::move(fn)) {}
+
+    void start(RunState& run) override {
+        _reorderer.reset(run.liveItems);
+        StageCore<In>::start(run);
+    }
+
+protected:
+    void process(const uint64_t seq, In&& value, WorkerCounters& counters) override {
+        if (this->_order == StageOrder::Unordered) {
+            consume(std::move(value), counters);
+            return;
+        }
+        _reorderer.submit(seq, std::move(value), [this, &counters](In&& ready) { consume(std::move(ready), counters); });
+    }
+
+    void finish() override {}
+
+private:
+    // Gives the item's token back once the sink is done with it. If the sink throws, the token
+    // is left for workerLoop, which releases one for the item that failed.
+    void consume(In&& value, WorkerCounters& counters) {
+        counters.time([&] { _fn(std::move(value)); });
+        this->_run->release();
+    }
+
+    F _fn;
+    Reorderer<In> _reorderer;
+};
+
+struct Parts {
+    size_t capacity = 0;
+    std::vector<std::unique_ptr<StageBase>> stages;
+};
+
+} // namespace pipeline_detail
+
+/**
+ * @brief A chain of stages, each with its own worker threads, connected by
+ * bounded queues. Built with PipelineBuilder.
+ *
+ * run pulls items from a source on the calling thread and pushes them into
+ * the first stage's queue. Each stage's workers pop an item, apply the stage
+ * function and push the result into the next stage's queue. Every queue is
+ * bounded, so a slow stage fills its input queue, the stage before it blocks
+ * on push, and so on up to the source: memory stays bounded and the whole
+ * pipeline runs at the speed of its slowest stage. The source also stops
+ * while as many items are in flight as the queues and workers can hold, which
+ * bounds what ordered stages buffer while they wait for a straggler. Items
+ * are moved from queue to function to queue and never copied, so move-only
+ * types work.
+ *
+ * If a stage function throws, the source stops, the remaining items are
+ * drained without being processed and run rethrows the first exception.
+ *
+ * @tparam Source The type of the items the source produces.
+ */
+template <typename Source>
+class Pipeline {
+public:
+    /**
+     * @brief Runs the pipeline until the source is exhausted and every stage
+     * has finished, then returns the per-stage statistics.
+     * @param source Called repeatedly; returns the next item, or std::nullopt
+     *        at the end.
+     * @param samplePeriod How often queue occupancy is sampled.
+     */
+    template <typename Generator>
+    PipelineStats run(Generator&& source,
+                      const std::chrono::microseconds samplePeriod = std::chrono::microseconds(500)) {
+        pipeline_detail::RunState state(liveItems());
+        std::vector<double> queuedSum(_parts.stages.size(), 0);
+        std::vector<size_t> queuedMax(_parts.stages.size(), 0);
+        uint64_t samples = 0;
+        std::atomic<bool> sampling{true};
+
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& stage : _parts.stages) {
+            stage->start(state);
+        }
+        std::thread sampler([&] {
+            while (sampling.load(std::memory_order_relaxed)) {
+                for (size_t i = 0; i < _parts.stages.size(); ++i) {
+                    const size_t queued = _parts.stages[i]->queued();
+                    queuedSum[i] += static_cast<double>(queued);
+                    queuedMax[i] = std::max(queuedMax[i], queued);
+                }
+                ++samples;
+                std::this_thread::sleep_for(samplePeriod);
+            }
+        });
+
+        uint64_t seq = 0;
+        try {
+            while (!state.failed.load(std::memory_order_acquire)) {
+                state.acquire();
+                if (state.failed.load(std::memory_order_acquire)) {
+                    break;
+                }
+                std::optional<Source> item = source();
+                if (!item) {
+                    state.release();
+                    break;
+                }
+                _input->push(pipeline_detail::Envelope<Source>{seq++, std::move(item)});
+            }
+        } catch (...) {
+            state.fail(std::current_exception());
+        }
+        for (size_t i = 0; i < _inputWorkers; ++i) {
+            _input->push(pipeline_detail::Envelope<Source>{});
+        }
+
+        for (auto& stage : _parts.stages) {
+            stage->join();
+        }
+        const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+        sampling.store(false, std::memory_order_relaxed);
+        sampler.join();
+
+        if (state.error) {
+            std::rethrow_exception(state.error);
+        }
+        PipelineStats stats;
+        stats.wallSeconds = wall.count();
+        for (size_t i = 0; i < _parts.stages.size(); ++i) {
+            StageStats s = _parts.stages[i]->stats();
+            s.wallSeconds = wall.count();
+            s.meanQueued = samples ? queuedSum[i] / static_cast<double>(samples) : 0;
+            s.maxQueued = queuedMax[i];
+            stats.stages.push_back(std::move(s));
+        }
+        return stats;
+    }
+
+private:
+    template <typename, typename>
+    friend class PipelineBuilder;
+
+    // Enough for every queue to fill and every worker to hold an item, so
+    // the limit only bites when ordered stages are holding results back.
+    size_t liveItems() const {
+        size_t items = 0;
+        for (const auto& stage : _parts.stages) {
+            items += stage->queueCapacity() + stage->workers();
+        }
+        return items;
+    }
+
+    Pipeline(pipeline_detail::Parts parts, pipeline_detail::Channel<Source>* input, const size_t inputWorkers)
+        : _parts(std::move(parts)), _input(input), _inputWorkers(inputWorkers) {}
+
+    pipeline_detail::Parts _parts;
+    pipeline_detail::Channel<Source>* _input;
+    size_t _inputWorkers;
+};
+
+/**
+ * @brief Builds a Pipeline one stage at a time, checking at compile time
+ * that each stage accepts what the previous one produces:
+ *
+ * @code
+ *   auto pipeline = PipelineBuilder<std::string>(1024)
+ *       .stage("parse", 2, StageOrder::Unordered, [](std::string line) { return parse(line); })
+ *       .stage("transform", 4, StageOrder::Unordered, [](Record r) { return enrich(std::move(r)); })
+ *       .sink("aggregate", 1, StageOrder::Ordered, [&](Record r) { totals.add(r); });
+ *   PipelineStats stats = pipeline.run(readLine);
+ * @endcode
+ *
+ * @tparam Source The type of the items the source produces.
+ * @tparam Current The type the last stage added produces.
+ */
+template <typename Source, typename Current = Source>
+class PipelineBuilder {
+public:
+    /**
+     * @param queueCapacity Capacity of each stage's input queue (rounded up
+     *        to a power of two), and the reordering window of ordered stages.
+     */
+    explicit PipelineBuilder(const size_t queueCapacity = 1024) { _parts.capacity = queueCapacity; }
+
+    /**
+     * @brief Adds a stage that maps each item to a new one.
+     * @param workers Threads running fn concurrently.
+     * @param fn Called with each item as an rvalue; must be thread-safe if
+     *        workers > 1.
+     */
+    template <typename F>
+    auto stage(std::string name, const size_t workers, const StageOrder order, F fn)
+        -> PipelineBuilder<Source, std::invoke_result_t<F&, Current&&>> {
+        using Out = std::invoke_result_t<F&, Current&&>;
+        static_assert(!std::is_void_v<Out>, "Use sink for a stage that returns nothing.");
+        auto stage = std::make_unique<pipeline_detail::TransformStage<Current, Out, F>>(
+            std::move(name), workers, order, _parts.capacity, std::move(fn));
+        pipeline_detail::Producing<Out>* last = stage.get();
+        attach(*stage);
+        _parts.stages.push_back(std::move(stage));
+        return PipelineBuilder<Source, Out>(std::move(_parts), _input, _inputWorkers, last);
+    }
+
+    /**
+     * @brief Adds the final stage, which consumes each item, and returns the
+     * finished pipeline.
+     */
+    template <typename F>
+    Pipeline<Source> sink(std::string name, const size_t workers, const StageOrder order, F fn) {
+        auto stage = std::make_unique<pipeline_detail::SinkStage<Current, F>>(std::move(name), workers, order,
+                                                                              _parts.capacity, std::move(fn));
+        attach(*stage);
+        _parts.stages.push_back(std::move(stage));
+        return Pipeline<Source>(std::move(_parts), _input, _inputWorkers);
+    }
+
+private:
+    template <typename, typename>
+    friend class PipelineBuilder;
+
+    PipelineBuilder(pipeline_detail::Parts parts, pipeline_detail::Channel<Source>* input,
+                    const size_t inputWorkers, pipeline_detail::Producing<Current>* last)
+        : _parts(std::move(parts)), _input(input), _inputWorkers(inputWorkers), _last(last) {}
+
+    void attach(pipeline_detail::StageCore<Current>& stage) {
+        if (_last) {
+            _last->connect(&stage.input(), stage.workers());
+        } else if constexpr (std::is_same_v<Source, Current>) {
+            _input = &stage.input();
+            _inputWorkers = stage.workers();
+        }
+    }
+
+    pipeline_detail::Parts _parts;
+    pipeline_detail::Channel<Source>* _input = nullptr;
+    size_t _inputWorkers = 0;
+    pipeline_detail::Producing<Current>* _last = nullptr;
+};
+
+#endif //CPP_DATASTRUCTURES_PIPELINE_H
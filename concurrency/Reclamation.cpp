@@ -0,0 +1,296 @@
+#include "Reclamation.h"
+#include "TreiberStack.h"
+#include "MichaelScottQueue.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using reclamation::Epoch;
+using reclamation::HazardPointers;
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+template <typename Reclaimer>
+void testSequentialOrder() {
+    TreiberStack<std::string, Reclaimer> stack;
+    MichaelScottQueue<std::string, Reclaimer> queue;
+    assert(stack.empty() && queue.empty());
+    for (int i = 0; i < 100; ++i) {
+        stack.push(std::to_string(i));
+        queue.push(std::to_string(i));
+    }
+    assert(!stack.empty() && !queue.empty());
+    std::string out;
+    for (int i = 99; i >= 0; --i) {
+        assert(stack.try_pop(out) && out == std::to_string(i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        assert(queue.try_pop(out) && out == std::to_string(i));
+    }
+    assert(!stack.try_pop(out) && !queue.try_pop(out));
+    Reclaimer::collect();
+    assert(Reclaimer::unreclaimed() == 0);
+}
+
+// Every thread pushes and pops in a loop; the values popped (during the run
+// and when draining at the end) must be exactly the values pushed. The
+// threads exit with nodes still pending, which the final collect must free.
+template <typename Reclaimer>
+void testStackStress() {
+    constexpr int threadCount = 4;
+    constexpr uint64_t perThread = 50000;
+    TreiberStack<uint64_t, Reclaimer> stack;
+    std::atomic<uint64_t> poppedSum{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&stack, &poppedSum, t] {
+            uint64_t local = 0;
+            uint64_t value;
+            for (uint64_t i = 0; i < perThread; ++i) {
+                stack.push(t * perThread + i);
+                if (i % 3 != 2 && stack.try_pop(value)) {
+                    local += value;
+                }
+            }
+            poppedSum += local;
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    uint64_t value;
+    while (stack.try_pop(value)) {
+        poppedSum += value;
+    }
+    const uint64_t n = threadCount * perThread;
+    assert(poppedSum == n * (n - 1) / 2);
+    Reclaimer::collect();
+    assert(Reclaimer::unreclaimed() == 0);
+}
+
+// Each consumer must see each producer's values in increasing order.
+template <typename Reclaimer>
+void testQueueStress() {
+    constexpr int producers = 3;
+    constexpr int consumers = 3;
+    constexpr uint64_t perProducer = 50000;
+    MichaelScottQueue<uint64_t, Reclaimer> queue;
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<bool> ordered{true};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (uint64_t i = 0; i < perProducer; ++i) {
+                queue.push(p * perProducer + i);
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::vector<int64_t> last(producers, -1);
+            uint64_t value;
+            while (received.load() < producers * perProducer) {
+                if (!queue.try_pop(value)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ++received;
+                sum += value;
+                const auto p = static_cast<size_t>(value / perProducer);
+                if (static_cast<int64_t>(value) <= last[p]) ordered = false;
+                last[p] = static_cast<int64_t>(value);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    const uint64_t n = producers * perProducer;
+    assert(received == n);
+    assert(sum == n * (n - 1) / 2);
+    assert(ordered);
+    assert(queue.empty());
+    Reclaimer::collect();
+    assert(Reclaimer::unreclaimed() == 0);
+}
+
+// Short-lived threads keep exiting with nodes still pending, which the
+// long-lived ones adopt and free while they may still be protected. Under
+// ThreadSanitizer this catches an orphan freed against a stale hazard scan.
+template <typename Reclaimer>
+void testThreadChurn() {
+    constexpr int waves = 200;
+    constexpr int churners = 2;
+    constexpr uint64_t perChurner = 300;
+    MichaelScottQueue<uint64_t, Reclaimer> queue;
+    std::atomic<uint64_t> pushedSum{0};
+    std::atomic<uint64_t> poppedSum{0};
+    std::atomic<bool> stop{false};
+    auto pushAndPop = [&queue, &pushedSum, &poppedSum](const uint64_t first, const uint64_t count) {
+        uint64_t pushed = 0, popped = 0, value;
+        for (uint64_t i = first; i < first + count; ++i) {
+            queue.push(i);
+            pushed += i;
+            if (queue.try_pop(value)) {
+                popped += value;
+            }
+        }
+        pushedSum += pushed;
+        poppedSum += popped;
+    };
+    std::vector<std::thread> steady;
+    for (int t = 0; t < 2; ++t) {
+        steady.emplace_back([&stop, &pushAndPop] {
+            while (!stop.load()) {
+                pushAndPop(0, 64);
+            }
+        });
+    }
+    for (int wave = 0; wave < waves; ++wave) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < churners; ++t) {
+            threads.emplace_back(pushAndPop, wave * perChurner, perChurner);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+    stop = true;
+    for (auto& t : steady) {
+        t.join();
+    }
+    uint64_t value;
+    while (queue.try_pop(value)) {
+        poppedSum += value;
+    }
+    assert(poppedSum == pushedSum);
+    Reclaimer::collect();
+    assert(Reclaimer::unreclaimed() == 0);
+}
+
+// A reader stalls inside a guard holding one node while another thread
+// replaces and retires 10000 nodes. Epoch reclamation can free none of them
+// until the reader leaves; hazard pointers can free all but the one held.
+template <typename Reclaimer>
+size_t garbageBehindStalledReader() {
+    struct Node {
+        uint64_t value;
+    };
+    std::atomic<Node*> shared{new Node{0}};
+    std::atomic<int> phase{0};
+    std::thread reader([&shared, &phase] {
+        typename Reclaimer::Guard guard;
+        const Node* held = guard.protect(shared, 0);
+        phase.store(1);
+        while (phase.load() != 2) {
+            std::this_thread::yield();
+        }
+        assert(held->value == 0);
+    });
+    while (phase.load() != 1) {
+        std::this_thread::yield();
+    }
+    for (uint64_t i = 1; i <= 10000; ++i) {
+        typename Reclaimer::Guard guard;
+        guard.retire(shared.exchange(new Node{i}));
+    }
+    Reclaimer::collect();
+    const size_t pending = Reclaimer::unreclaimed();
+    phase.store(2);
+    reader.join();
+    delete shared.load();
+    Reclaimer::collect();
+    assert(Reclaimer::unreclaimed() == 0);
+    return pending;
+}
+
+void testStalledReader() {
+    assert(garbageBehindStalledReader<Epoch>() == 10000);
+    assert(garbageBehindStalledReader<HazardPointers>() == 1);
+}
+
+void testHazardGuardsNest() {
+    HazardPointers::Guard outer;
+    {
+        HazardPointers::Guard a;
+        HazardPointers::Guard b;
+        HazardPointers::Guard c;
+        bool exception_caught = false;
+        try {
+            HazardPointers::Guard tooDeep;
+        } catch (const std::length_error&) {
+            exception_caught = true;
+        }
+        assert(exception_caught);
+    }
+    // The slots were given back.
+    HazardPointers::Guard again;
+}
+
+template <typename Structure>
+double opsPerSecond(const int threadCount, const uint64_t totalPairs) {
+    Structure structure;
+    const uint64_t perThread = totalPairs / threadCount;
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&structure, perThread] {
+            uint64_t value;
+            for (uint64_t i = 0; i < perThread; ++i) {
+                structure.push(i);
+                structure.try_pop(value);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return 2.0 * perThread * threadCount / elapsed.count();
+}
+
+void benchmarkReclaimers() {
+    constexpr uint64_t pairs = 2000000;
+    std::cout << "\nMillion operations/s, threads alternating push and pop ("
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    std::cout << "threads\tstack/epoch\tstack/hazard\tqueue/epoch\tqueue/hazard" << std::endl;
+    for (const int threads : {1, 2, 4, 8}) {
+        std::cout << threads << "\t" << opsPerSecond<TreiberStack<uint64_t, Epoch>>(threads, pairs) / 1e6 << "\t\t"
+                  << opsPerSecond<TreiberStack<uint64_t, HazardPointers>>(threads, pairs) / 1e6 << "\t\t"
+                  << opsPerSecond<MichaelScottQueue<uint64_t, Epoch>>(threads, pairs) / 1e6 << "\t\t"
+                  << opsPerSecond<MichaelScottQueue<uint64_t, HazardPointers>>(threads, pairs) / 1e6 << std::endl;
+    }
+}
+
+int main() {
+    test("Sequential Order (Epoch)", testSequentialOrder<Epoch>);
+    test("Sequential Order (Hazard Pointers)", testSequentialOrder<HazardPointers>);
+    test("Stack Stress (Epoch)", testStackStress<Epoch>);
+    test("Stack Stress (Hazard Pointers)", testStackStress<HazardPointers>);
+    test("Queue Stress (Epoch)", testQueueStress<Epoch>);
+    test("Queue Stress (Hazard Pointers)", testQueueStress<HazardPointers>);
+    test("Thread Churn (Epoch)", testThreadChurn<Epoch>);
+    test("Thread Churn (Hazard Pointers)", testThreadChurn<HazardPointers>);
+    test("Stalled Reader", testStalledReader);
+    test("Hazard Guards Nest", testHazardGuardsNest);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkReclaimers();
+    return 0;
+}
@@ -0,0 +1,495 @@
+#ifndef CPP_DATASTRUCTURES_RECLAMATION_H
+#define CPP_DATASTRUCTURES_RECLAMATION_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Safe memory reclamation for lock-free linked structures.
+ *
+ * A lock-free structure cannot delete a node as soon as it unlinks it,
+ * because another thread may have loaded a pointer to the node just before
+ * and still be about to read it. Both schemes here defer the delete until
+ * no thread can hold such a pointer, and both expose the same API, so a
+ * structure takes the scheme as a template parameter:
+ *
+ * @code
+ *   typename Reclaimer::Guard guard;          // before touching shared nodes
+ *   Node* node = guard.protect(_head, 0);     // safe to read until guard ends
+ *   ...unlink node with a CAS...
+ *   guard.retire(node);                       // deleted once nobody can see it
+ * @endcode
+ *
+ * - Epoch: epoch-based reclamation. A guard costs one store and one load
+ *   and protect is a plain acquire load, so it is the fast choice. But one
+ *   thread stalled inside a guard stops every thread's garbage from being
+ *   freed, so memory is unbounded in the worst case.
+ * - HazardPointers: each protect publishes the pointer in a per-thread
+ *   slot and re-checks it, which costs a full fence per pointer. In return a
+ *   retired node is freed as soon as no slot holds it, so at most a fixed
+ *   number of nodes per thread are ever pending, even with stalled threads.
+ *
+ * Both use one process-wide domain, so nodes can be retired from any
+ * structure and any thread. Per-thread state is registered on first use and
+ * recycled when the thread exits; anything still pending then is handed to
+ * the domain and freed by a later collection.
+ */
+namespace reclamation {
+
+namespace detail {
+
+struct Retired {
+    void* pointer;
+    void (*deleter)(void*);
+    uint64_t epoch;
+};
+
+template <typename T>
+void deleteAs(void* pointer) {
+    delete static_cast<T*>(pointer);
+}
+
+/**
+ * @brief Deletes every entry of retired for which canFree returns true and
+ * removes it from the vector.
+ * @return The number of nodes deleted.
+ */
+template <typename CanFree>
+size_t freeMatching(std::vector<Retired>& retired, CanFree&& canFree) {
+    const auto kept = std::partition(retired.begin(), retired.end(),
+                                     [&canFree](const Retired& r) { return !canFree(r); });
+    const auto freed = static_cast<size_t>(retired.end() - kept);
+    for (auto it = kept; it != retired.end(); ++it) {
+        it->deleter(it->pointer);
+    }
+    retired.erase(kept, retired.end());
+    return freed;
+}
+
+/**
+ * @brief The per-thread records of a domain, in a lock-free list that only
+ * grows. An exiting thread gives its record back and the next new thread
+ * reuses it, so the list is as long as the peak number of threads.
+ */
+template <typename Record>
+class RecordList {
+public:
+    Record* acquire() {
+        for (Record* r = _head.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            bool expected = false;
+            if (!r->owned.load(std::memory_order_relaxed) &&
+                r->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return r;
+            }
+        }
+        auto* record = new Record;
+        record->owned.store(true, std::memory_order_relaxed);
+        record->next = _head.load(std::memory_order_relaxed);
+        while (!_head.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+        _size.fetch_add(1, std::memory_order_relaxed);
+        return record;
+    }
+
+    void release(Record* record) { record->owned.store(false, std::memory_order_release); }
+
+    template <typename F>
+    void forEach(F&& visit) const {
+        for (const Record* r = _head.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            visit(*r);
+        }
+    }
+
+    size_t size() const { return _size.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<Record*> _head{nullptr};
+    std::atomic<size_t> _size{0};
+};
+
+/**
+ * @brief Retired nodes left behind by threads that exited before they could
+ * be freed.
+ */
+class Orphans {
+public:
+    void adopt(std::vector<Retired>& retired) {
+        if (retired.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _retired.insert(_retired.end(), retired.begin(), retired.end());
+        _count.store(_retired.size(), std::memory_order_relaxed);
+        retired.clear();
+    }
+
+    /**
+     * @brief Moves every orphan onto the end of into.
+     */
+    void takeAll(std::vector<Retired>& into) {
+        if (_count.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        into.insert(into.end(), _retired.begin(), _retired.end());
+        _retired.clear();
+        _count.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Frees the orphans for which canFree returns true. Skips the
+     * work if another thread is already doing it.
+     * @return The number of nodes freed.
+     */
+    template <typename CanFree>
+    size_t freeIf(CanFree&& canFree) {
+        if (_count.load(std::memory_order_relaxed) == 0) {
+            return 0;
+        }
+        std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+        if (!lock) {
+            return 0;
+        }
+        const size_t freed = freeMatching(_retired, canFree);
+        _count.store(_retired.size(), std::memory_order_relaxed);
+        return freed;
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<Retired> _retired;
+    std::atomic<size_t> _count{0};
+};
+
+} // namespace detail
+
+/**
+ * @brief Epoch-based reclamation (Fraser, 2004).
+ *
+ * A global epoch counter advances only when every thread inside a guard has
+ * observed the current value. A node is stamped with the epoch in which it
+ * was retired and freed once the epoch has moved two steps past it: by then
+ * every guard that was open when the node was unlinked has closed.
+ *
+ * Guards nest freely. protect's slot argument is accepted for compatibility
+ * with HazardPointers and ignored.
+ */
+class Epoch {
+private:
+    struct alignas(64) Record {
+        // (epoch << 1) | 1 while the owner is inside a guard, 0 otherwise.
+        std::atomic<uint64_t> state{0};
+        std::atomic<bool> owned{false};
+        Record* next = nullptr;
+    };
+
+    struct Domain {
+        alignas(64) std::atomic<uint64_t> epoch{1};
+        detail::RecordList<Record> records;
+        detail::Orphans orphans;
+        std::atomic<size_t> unreclaimed{0};
+    };
+
+    class Local {
+    public:
+        Local() : _record(domain().records.acquire()) {}
+
+        ~Local() {
+            collect();
+            domain().orphans.adopt(_retired);
+            domain().records.release(_record);
+        }
+
+        void enter() {
+            if (_nesting++ == 0) {
+                const uint64_t epoch = domain().epoch.load(std::memory_order_seq_cst);
+                _record->state.exchange((epoch << 1) | 1, std::memory_order_seq_cst);
+            }
+        }
+
+        void exit() {
+            if (--_nesting == 0) {
+                _record->state.store(0, std::memory_order_release);
+            }
+        }
+
+        void retire(void* pointer, void (*deleter)(void*)) {
+            _retired.push_back({pointer, deleter, domain().epoch.load(std::memory_order_seq_cst)});
+            domain().unreclaimed.fetch_add(1, std::memory_order_relaxed);
+            if (++_sinceCollect >= kCollectEvery) {
+                _sinceCollect = 0;
+                tryAdvance();
+                collect();
+            }
+        }
+
+        void collect() {
+            const uint64_t epoch = domain().epoch.load(std::memory_order_acquire);
+            const auto canFree = [epoch](const detail::Retired& r) { return r.epoch + 2 <= epoch; };
+            // The stamps only grow, so what can be freed is a prefix; a
+            // stalled guard then costs one comparison per collect, not a
+            // pass over the whole backlog.
+            const auto kept = std::find_if_not(_retired.begin(), _retired.end(), canFree);
+            for (auto it = _retired.begin(); it != kept; ++it) {
+                it->deleter(it->pointer);
+            }
+            size_t freed = static_cast<size_t>(kept - _retired.begin());
+            _retired.erase(_retired.begin(), kept);
+            freed += domain().orphans.freeIf(canFree);
+            domain().unreclaimed.fetch_sub(freed, std::memory_order_relaxed);
+        }
+
+    private:
+        Record* _record;
+        unsigned _nesting = 0;
+        unsigned _sinceCollect = 0;
+        std::vector<detail::Retired> _retired;
+    };
+
+    static constexpr unsigned kCollectEvery = 64;
+
+    static Domain& domain() {
+        // Never destroyed: threads may still exit after static destructors.
+        static Domain* const instance = new Domain;
+        return *instance;
+    }
+
+    static Local& local() {
+        thread_local Local state;
+        return state;
+    }
+
+    static void tryAdvance() {
+        Domain& d = domain();
+        uint64_t epoch = d.epoch.load(std::memory_order_seq_cst);
+        bool lagging = false;
+        d.records.forEach([epoch, &lagging](const Record& r) {
+            const uint64_t state = r.state.load(std::memory_order_seq_cst);
+            lagging |= (state & 1) != 0 && (state >> 1) != epoch;
+        });
+        if (!lagging) {
+            d.epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+        }
+    }
+
+public:
+    /**
+     * @brief Keeps every node reachable when the guard was opened alive
+     * until the guard closes.
+     */
+    class Guard {
+    public:
+        Guard() : _local(local()) { _local.enter(); }
+        ~Guard() { _local.exit(); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        /**
+         * @brief Loads source; the node stays valid while the guard is open.
+         */
+        template <typename T>
+        T* protect(const std::atomic<T*>& source, size_t = 0) const {
+            return source.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Schedules an unlinked node for deletion.
+         */
+        template <typename T>
+        void retire(T* node) const {
+            _local.retire(node, &detail::deleteAs<T>);
+        }
+
+    private:
+        Local& _local;
+    };
+
+    /**
+     * @brief Advances the epoch as far as the open guards allow and frees
+     * what the calling thread and exited threads retired, where safe.
+     */
+    static void collect() {
+        for (int i = 0; i < 3; ++i) {
+            tryAdvance();
+        }
+        local().collect();
+    }
+
+    /**
+     * @brief Returns the number of nodes retired but not yet freed.
+     */
+    static size_t unreclaimed() { return domain().unreclaimed.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Hazard pointers (Michael, 2004).
+ *
+ * protect publishes the pointer it loaded in one of the guard's slots and
+ * re-reads the source to check the node was not unlinked in between. A
+ * retired node is freed by a scan that finds it in no thread's slots. Scans
+ * run when a thread's retired list reaches twice the total number of slots,
+ * so each scan frees at least half the list and the pending garbage per
+ * thread stays bounded.
+ *
+ * Each guard owns kSlotsPerGuard slots; guards may nest kSlotsPerThread /
+ * kSlotsPerGuard deep.
+ */
+class HazardPointers {
+public:
+    static constexpr size_t kSlotsPerGuard = 2;
+    static constexpr size_t kSlotsPerThread = 8;
+
+private:
+    struct alignas(64) Record {
+        std::array<std::atomic<void*>, kSlotsPerThread> hazards{};
+        std::atomic<bool> owned{false};
+        Record* next = nullptr;
+    };
+
+    struct Domain {
+        detail::RecordList<Record> records;
+        detail::Orphans orphans;
+        std::atomic<size_t> unreclaimed{0};
+    };
+
+    class Local {
+    public:
+        Local() : _record(domain().records.acquire()) {}
+
+        ~Local() {
+            scan();
+            domain().orphans.adopt(_retired);
+            domain().records.release(_record);
+        }
+
+        size_t reserve() {
+            if (_used + kSlotsPerGuard > kSlotsPerThread) {
+                throw std::length_error("HazardPointers guards nested too deeply.");
+            }
+            const size_t base = _used;
+            _used += kSlotsPerGuard;
+            return base;
+        }
+
+        void unreserve(const size_t base) {
+            for (size_t i = base; i < base + kSlotsPerGuard; ++i) {
+                _record->hazards[i].store(nullptr, std::memory_order_release);
+            }
+            _used = base;
+        }
+
+        std::atomic<void*>& slot(const size_t i) { return _record->hazards[i]; }
+
+        void retire(void* pointer, void (*deleter)(void*)) {
+            _retired.push_back({pointer, deleter, 0});
+            domain().unreclaimed.fetch_add(1, std::memory_order_relaxed);
+            if (_retired.size() >= std::max<size_t>(64, 2 * kSlotsPerThread * domain().records.size())) {
+                scan();
+            }
+        }
+
+        void scan() {
+            // Take the orphans before reading the hazards: a node adopted
+            // after the snapshot may be protected by a hazard it missed.
+            domain().orphans.takeAll(_retired);
+            std::vector<void*> hazards;
+            domain().records.forEach([&hazards](const Record& r) {
+                for (const auto& hazard : r.hazards) {
+                    if (void* p = hazard.load(std::memory_order_seq_cst)) {
+                        hazards.push_back(p);
+                    }
+                }
+            });
+            std::sort(hazards.begin(), hazards.end());
+            const auto canFree = [&hazards](const detail::Retired& r) {
+                return !std::binary_search(hazards.begin(), hazards.end(), r.pointer);
+            };
+            const size_t freed = detail::freeMatching(_retired, canFree);
+            domain().unreclaimed.fetch_sub(freed, std::memory_order_relaxed);
+        }
+
+    private:
+        Record* _record;
+        size_t _used = 0;
+        std::vector<detail::Retired> _retired;
+    };
+
+    static Domain& domain() {
+        // Never destroyed: threads may still exit after static destructors.
+        static Domain* const instance = new Domain;
+        return *instance;
+    }
+
+    static Local& local() {
+        thread_local Local state;
+        return state;
+    }
+
+public:
+    /**
+     * @brief Owns kSlotsPerGuard hazard slots; clears them when it closes.
+     */
+    class Guard {
+    public:
+        Guard() : _local(local()), _base(_local.reserve()) {}
+        ~Guard() { _local.unreserve(_base); }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        /**
+         * @brief Loads source and publishes the result in the given slot,
+         * replacing what the slot protected before. The node stays valid
+         * until the slot is reused or the guard closes.
+         * @param slot A slot index below kSlotsPerGuard.
+         */
+        template <typename T>
+        T* protect(const std::atomic<T*>& source, const size_t slot) {
+            std::atomic<void*>& hazard = _local.slot(_base + slot);
+            T* pointer = source.load(std::memory_order_relaxed);
+            while (true) {
+                hazard.store(pointer, std::memory_order_seq_cst);
+                T* current = source.load(std::memory_order_seq_cst);
+                if (current == pointer) {
+                    return pointer;
+                }
+                pointer = current;
+            }
+        }
+
+        /**
+         * @brief Schedules an unlinked node for deletion.
+         */
+        template <typename T>
+        void retire(T* node) const {
+            _local.retire(node, &detail::deleteAs<T>);
+        }
+
+    private:
+        Local& _local;
+        const size_t _base;
+    };
+
+    /**
+     * @brief Frees what the calling thread and exited threads retired that
+     * no slot protects.
+     */
+    static void collect() { local().scan(); }
+
+    /**
+     * @brief Returns the number of nodes retired but not yet freed.
+     */
+    static size_t unreclaimed() { return domain().unreclaimed.load(std::memory_order_relaxed); }
+};
+
+} // namespace reclamation
+
+#endif //CPP_DATASTRUCTURES_RECLAMATION_H
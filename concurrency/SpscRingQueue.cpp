@@ -0,0 +1,175 @@
+#include "SpscRingQueue.h"
+#include "CondvarQueue.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testFifoAndBounds() {
+    SpscRingQueue<int> queue(4);
+    int out = 0;
+    assert(!queue.try_pop(out));
+    for (int i = 0; i < 4; ++i) {
+        assert(queue.try_push(i));
+    }
+    assert(!queue.try_push(4));
+    for (int i = 0; i < 4; ++i) {
+        assert(queue.try_pop(out) && out == i);
+    }
+    assert(!queue.try_pop(out));
+}
+
+void testBulkWrapsAndStopsWhenFull() {
+    SpscRingQueue<int> queue(8);
+    std::vector<int> in(6);
+    std::iota(in.begin(), in.end(), 0);
+    std::vector<int> out(8);
+
+    assert(queue.push_bulk(in) == 6);
+    assert(queue.pop_bulk(std::span(out).first(5)) == 5);
+    // Tail is at 6 and head at 5: the next batch wraps past the end.
+    std::iota(in.begin(), in.end(), 6);
+    assert(queue.push_bulk(in) == 6);
+    assert(queue.push_bulk(in) == 1);
+    assert(queue.pop_bulk(out) == 8);
+    const std::vector<int> expected = {5, 6, 7, 8, 9, 10, 11, 6};
+    assert(out == expected);
+    assert(queue.pop_bulk(out) == 0);
+}
+
+void testMovesStrings() {
+    SpscRingQueue<std::string> queue(2);
+    queue.push(std::string(100, 'a'));
+    assert(queue.pop() == std::string(100, 'a'));
+}
+
+void testTwoThreadsInOrder() {
+    constexpr uint64_t items = 1000000;
+    SpscRingQueue<uint64_t> queue(256);
+    std::thread producer([&queue] {
+        std::vector<uint64_t> batch(37);
+        uint64_t next = 0;
+        while (next < items) {
+            const size_t n = std::min<uint64_t>(batch.size(), items - next);
+            for (size_t i = 0; i < n; ++i) batch[i] = next + i;
+            size_t pushed = 0;
+            while (pushed < n) {
+                pushed += queue.push_bulk(std::span<const uint64_t>(batch).subspan(pushed, n - pushed));
+                if (pushed < n) std::this_thread::yield();
+            }
+            next += n;
+        }
+    });
+    uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < items) {
+        uint64_t value;
+        if (expected % 2 == 0 && queue.try_pop(value)) {
+            ordered &= value == expected++;
+            continue;
+        }
+        std::vector<uint64_t> out(23);
+        const size_t n = queue.pop_bulk(out);
+        for (size_t i = 0; i < n; ++i) {
+            ordered &= out[i] == expected++;
+        }
+        if (n == 0) std::this_thread::yield();
+    }
+    producer.join();
+    assert(ordered);
+}
+
+uint64_t benchmarkSink = 0;
+
+double condvarItemsPerSecond(const uint64_t items) {
+    CondvarQueue<uint64_t> queue(4096);
+    uint64_t sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::thread producer([&queue, items] {
+        for (uint64_t i = 0; i < items; ++i) queue.push(i);
+    });
+    for (uint64_t i = 0; i < items; ++i) sum += queue.pop();
+    producer.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink += sum;
+    return items / elapsed.count();
+}
+
+double singleItemsPerSecond(const uint64_t items) {
+    SpscRingQueue<uint64_t> queue(4096);
+    uint64_t sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::thread producer([&queue, items] {
+        for (uint64_t i = 0; i < items; ++i) queue.push(i);
+    });
+    for (uint64_t i = 0; i < items; ++i) sum += queue.pop();
+    producer.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink += sum;
+    return items / elapsed.count();
+}
+
+double bulkItemsPerSecond(const uint64_t items, const size_t batchSize) {
+    SpscRingQueue<uint64_t> queue(4096);
+    uint64_t sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::thread producer([&queue, items, batchSize] {
+        std::vector<uint64_t> batch(batchSize);
+        std::iota(batch.begin(), batch.end(), 0);
+        for (uint64_t sent = 0; sent < items;) {
+            const size_t want = std::min<uint64_t>(batchSize, items - sent);
+            const size_t n = queue.push_bulk(std::span<const uint64_t>(batch).first(want));
+            if (n == 0) std::this_thread::yield();
+            sent += n;
+        }
+    });
+    std::vector<uint64_t> out(batchSize);
+    for (uint64_t received = 0; received < items;) {
+        const size_t n = queue.pop_bulk(out);
+        if (n == 0) std::this_thread::yield();
+        for (size_t i = 0; i < n; ++i) sum += out[i];
+        received += n;
+    }
+    producer.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink += sum;
+    return items / elapsed.count();
+}
+
+void benchmarkThroughput() {
+    constexpr uint64_t items = 50000000;
+    std::cout << "\nMillion 8-byte items/s, one producer and one consumer ("
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    std::cout << "mutex+condvar\t\t" << condvarItemsPerSecond(items / 20) / 1e6 << std::endl;
+    std::cout << "SPSC push/pop\t\t" << singleItemsPerSecond(items) / 1e6 << std::endl;
+    for (const size_t batch : {16, 64, 256}) {
+        std::cout << "SPSC bulk x" << batch << "\t\t" << bulkItemsPerSecond(items, batch) / 1e6 << std::endl;
+    }
+}
+
+int main() {
+    test("FIFO And Bounds", testFifoAndBounds);
+    test("Bulk Wraps And Stops When Full", testBulkWrapsAndStopsWhenFull);
+    test("Moves Strings", testMovesStrings);
+    test("Two Threads In Order", testTwoThreadsInOrder);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkThroughput();
+    return 0;
+}
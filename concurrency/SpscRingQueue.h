@@ -0,0 +1,179 @@
+#ifndef CPP_DATASTRUCTURES_SPSCRINGQUEUE_H
+#define CPP_DATASTRUCTURES_SPSCRINGQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief A bounded wait-free single-producer single-consumer ring.
+ *
+ * With exactly one producer and one consumer, no CAS is needed: the producer
+ * alone advances the tail and the consumer alone advances the head, and each
+ * publishes its cursor with a release store. Every operation finishes in a
+ * bounded number of steps.
+ *
+ * Each side keeps a private copy of the other side's cursor and only re-reads
+ * the shared one when the copy says the ring is full (or empty), so in steady
+ * state the cursors' cache lines are not bounced back and forth on every item.
+ * push_bulk and pop_bulk move a whole span and publish it with one store,
+ * which amortises the remaining cross-core traffic over the batch.
+ *
+ * Calling the producer methods from more than one thread, or the consumer
+ * methods from more than one thread, is undefined behaviour.
+ *
+ * @tparam T The element type; must be default constructible and movable.
+ */
+template <typename T>
+class SpscRingQueue {
+    static_assert(std::is_default_constructible_v<T>, "SpscRingQueue requires default-constructible elements");
+
+public:
+    /**
+     * @brief Constructs a queue holding at least capacity elements.
+     * @param capacity The minimum capacity; rounded up to a power of two.
+     * @throws std::invalid_argument if capacity is 0.
+     */
+    explicit SpscRingQueue(const size_t capacity)
+        : _mask(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1), _slots(new T[_mask + 1]) {
+        if (capacity == 0) {
+            throw std::invalid_argument("SpscRingQueue capacity must be positive.");
+        }
+    }
+
+    SpscRingQueue(const SpscRingQueue&) = delete;
+    SpscRingQueue& operator=(const SpscRingQueue&) = delete;
+
+    /**
+     * @brief Pushes an element if the queue is not full. Producer only.
+     * @return true if the element was pushed.
+     */
+    template <typename U>
+    bool try_push(U&& value) {
+        const size_t tail = _producer.tail.load(std::memory_order_relaxed);
+        if (tail - _producer.cachedHead == capacity()) {
+            _producer.cachedHead = _consumer.head.load(std::memory_order_acquire);
+            if (tail - _producer.cachedHead == capacity()) {
+                return false;
+            }
+        }
+        _slots[tail & _mask] = std::forward<U>(value);
+        _producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pops the oldest element if the queue is not empty. Consumer only.
+     * @param out Receives the element.
+     * @return true if an element was popped.
+     */
+    bool try_pop(T& out) {
+        const size_t head = _consumer.head.load(std::memory_order_relaxed);
+        if (head == _consumer.cachedTail) {
+            _consumer.cachedTail = _producer.tail.load(std::memory_order_acquire);
+            if (head == _consumer.cachedTail) {
+                return false;
+            }
+        }
+        out = std::move(_slots[head & _mask]);
+        _consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pushes as many leading elements of items as fit. Producer only.
+     * @param items The elements to push, in order.
+     * @return The number of elements pushed, from 0 to items.size().
+     */
+    size_t push_bulk(std::span<const T> items) {
+        const size_t tail = _producer.tail.load(std::memory_order_relaxed);
+        size_t free = capacity() - (tail - _producer.cachedHead);
+        if (free < items.size()) {
+            _producer.cachedHead = _consumer.head.load(std::memory_order_acquire);
+            free = capacity() - (tail - _producer.cachedHead);
+        }
+        const size_t n = std::min(free, items.size());
+        const size_t start = tail & _mask;
+        const size_t first = std::min(n, capacity() - start);
+        std::copy_n(items.begin(), first, _slots.get() + start);
+        std::copy_n(items.begin() + first, n - first, _slots.get());
+        _producer.tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Pops up to out.size() of the oldest elements. Consumer only.
+     * @param out Receives the elements, in order.
+     * @return The number of elements popped.
+     */
+    size_t pop_bulk(std::span<T> out) {
+        const size_t head = _consumer.head.load(std::memory_order_relaxed);
+        size_t available = _consumer.cachedTail - head;
+        if (available < out.size()) {
+            _consumer.cachedTail = _producer.tail.load(std::memory_order_acquire);
+            available = _consumer.cachedTail - head;
+        }
+        const size_t n = std::min(available, out.size());
+        const size_t start = head & _mask;
+        const size_t first = std::min(n, capacity() - start);
+        std::move(_slots.get() + start, _slots.get() + start + first, out.begin());
+        std::move(_slots.get(), _slots.get() + (n - first), out.begin() + first);
+        _consumer.head.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Pushes an element, waiting while the queue is full. Producer only.
+     */
+    template <typename U>
+    void push(U&& value) {
+        while (!try_push(std::forward<U>(value))) {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Pops the oldest element, waiting while the queue is empty.
+     * Consumer only.
+     */
+    T pop() {
+        T out;
+        while (!try_pop(out)) {
+            std::this_thread::yield();
+        }
+        return out;
+    }
+
+    /**
+     * @brief Returns the number of elements the queue can hold.
+     */
+    size_t capacity() const { return _mask + 1; }
+
+private:
+    // Written by the producer; cachedHead is the producer's copy of head.
+    struct alignas(64) ProducerCursor {
+        std::atomic<size_t> tail{0};
+        size_t cachedHead = 0;
+    };
+
+    // Written by the consumer; cachedTail is the consumer's copy of tail.
+    struct alignas(64) ConsumerCursor {
+        std::atomic<size_t> head{0};
+        size_t cachedTail = 0;
+    };
+
+    const size_t _mask;
+    const std::unique_ptr<T[]> _slots;
+
+    ProducerCursor _producer;
+    ConsumerCursor _consumer;
+};
+
+#endif //CPP_DATASTRUCTURES_SPSCRINGQUEUE_H
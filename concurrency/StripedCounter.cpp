@@ -0,0 +1,126 @@
+#include "StripedCounter.h"
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testSingleThread() {
+    StripedCounter counter(3);
+    assert(counter.stripes() == 4);
+    assert(counter.load() == 0);
+    counter.increment();
+    counter.add(41);
+    counter.decrement();
+    assert(counter.load() == 41);
+    counter.reset();
+    assert(counter.load() == 0);
+}
+
+// The four threads from LockFreeConcurrency.cpp, plus more threads than
+// stripes so that some threads share a cell.
+void testConcurrentIncrements() {
+    for (const int threadCount : {4, 13}) {
+        StripedCounter counter(8);
+        constexpr int increments = 250000;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&counter] {
+                for (int i = 0; i < increments; ++i) {
+                    counter.increment();
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        assert(counter.load() == static_cast<int64_t>(threadCount) * increments);
+    }
+}
+
+// Runs work(threadIndex) on the given number of threads, all released at
+// once, and returns the elapsed seconds.
+double timeThreads(const int threadCount, const std::function<void(int)>& work) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&go, &work, t] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            work(t);
+        });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void benchmarkScaling() {
+    constexpr int64_t totalIncrements = 32000000;
+    std::cout << "\nMillion increments/s, " << totalIncrements / 1000000 << "M increments split over the threads ("
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    std::cout << "threads\tone atomic\tunpadded per-thread\tStripedCounter" << std::endl;
+    for (const int threadCount : {1, 2, 4, 8, 16, 32, 64}) {
+        const int64_t perThread = totalIncrements / threadCount;
+        const double total = static_cast<double>(perThread * threadCount);
+
+        // The counter from LockFreeConcurrency.cpp.
+        std::atomic<int64_t> single{0};
+        const double singleTime = timeThreads(threadCount, [&single, perThread](int) {
+            for (int64_t i = 0; i < perThread; ++i) {
+                single.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        assert(single.load() == perThread * threadCount);
+
+        // One atomic per thread but packed together: no logical sharing,
+        // yet eight of them share each cache line.
+        const auto packed = std::make_unique<std::atomic<int64_t>[]>(threadCount);
+        const double packedTime = timeThreads(threadCount, [&packed, perThread](const int t) {
+            for (int64_t i = 0; i < perThread; ++i) {
+                packed[t].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        StripedCounter striped;
+        const double stripedTime = timeThreads(threadCount, [&striped, perThread](int) {
+            for (int64_t i = 0; i < perThread; ++i) {
+                striped.increment();
+            }
+        });
+        assert(striped.load() == perThread * threadCount);
+
+        std::cout << threadCount << "\t" << total / singleTime / 1e6 << "\t\t" << total / packedTime / 1e6
+                  << "\t\t\t" << total / stripedTime / 1e6 << std::endl;
+    }
+}
+
+int main() {
+    test("Single Thread", testSingleThread);
+    test("Concurrent Increments", testConcurrentIncrements);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkScaling();
+    return 0;
+}
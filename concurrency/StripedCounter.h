@@ -0,0 +1,106 @@
+#ifndef CPP_DATASTRUCTURES_STRIPEDCOUNTER_H
+#define CPP_DATASTRUCTURES_STRIPEDCOUNTER_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+/**
+ * @brief A counter for many writers and few readers, in the style of Java's
+ * LongAdder.
+ *
+ * A single std::atomic counter makes every increment take ownership of the
+ * same cache line, so with several cores incrementing, most of each
+ * fetch_add is spent waiting for that line. StripedCounter instead gives
+ * each thread its own cell, on its own cache line, and increments it with a
+ * relaxed fetch_add. The line stays in the writer's cache and increments
+ * from different threads never touch the same line.
+ *
+ * The cost moves to load, which sums every cell. The sum is exact once the
+ * writers have stopped (or been joined). While they are running it is only
+ * approximate and not linearizable: each cell is read at a different moment,
+ * so the sum can mix adds from either side of a concurrent one. With
+ * decrements or negative adds it may be a value the counter never held, such
+ * as a count below zero for a counter that never went negative.
+ *
+ * Threads get a cell on first use, round-robin. With more threads than
+ * stripes, some threads share a cell, which is still correct but contends
+ * again.
+ */
+class StripedCounter {
+public:
+    /**
+     * @brief Constructs a counter at zero.
+     * @param stripes Number of cells, rounded up to a power of two; 0 means
+     *        twice the number of hardware threads.
+     */
+    explicit StripedCounter(size_t stripes = 0) {
+        if (stripes == 0) {
+            stripes = 2 * std::max(1u, std::thread::hardware_concurrency());
+        }
+        _mask = std::bit_ceil(stripes) - 1;
+        _cells = std::make_unique<Cell[]>(_mask + 1);
+    }
+
+    StripedCounter(const StripedCounter&) = delete;
+    StripedCounter& operator=(const StripedCounter&) = delete;
+
+    /**
+     * @brief Adds delta to the calling thread's cell.
+     */
+    void add(const int64_t delta) {
+        _cells[threadIndex() & _mask].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void increment() { add(1); }
+
+    void decrement() { add(-1); }
+
+    /**
+     * @brief Returns the sum of all cells: exact when no add runs
+     * concurrently, an approximate, non-linearizable total otherwise.
+     */
+    int64_t load() const {
+        int64_t sum = 0;
+        for (size_t i = 0; i <= _mask; ++i) {
+            sum += _cells[i].value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Sets every cell to zero. Adds made concurrently may be lost.
+     */
+    void reset() {
+        for (size_t i = 0; i <= _mask; ++i) {
+            _cells[i].value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Returns the number of cells.
+     */
+    size_t stripes() const { return _mask + 1; }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<int64_t> value{0};
+    };
+
+    // Threads are numbered on first use; every counter uses the same number,
+    // so a thread's cell index is consistent and neighbouring threads differ.
+    static size_t threadIndex() {
+        static std::atomic<size_t> nextThread{0};
+        thread_local const size_t index = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    size_t _mask = 0;
+    std::unique_ptr<Cell[]> _cells;
+};
+
+#endif //CPP_DATASTRUCTURES_STRIPEDCOUNTER_H
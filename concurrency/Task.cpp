@@ -0,0 +1,302 @@
+#include "Task.h"
+#include "CoroutineExecutor.h"
+#include "AsyncQueue.h"
+#include "CondvarQueue.h"
+#include <iostream>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+Task<int> answer() {
+    co_return 42;
+}
+
+Task<int> failing() {
+    throw std::runtime_error("boom");
+    co_return 0;
+}
+
+Task<int> addOne(Task<int> inner) {
+    co_return co_await inner + 1;
+}
+
+void testSyncWaitValuesAndExceptions() {
+    assert(syncWait(answer()) == 42);
+    assert(syncWait(addOne(answer())) == 43);
+    bool exception_caught = false;
+    try {
+        syncWait(addOne(failing()));
+    } catch (const std::runtime_error& e) {
+        exception_caught = std::string(e.what()) == "boom";
+    }
+    assert(exception_caught);
+}
+
+Task<uint64_t> identity(const uint64_t x) {
+    co_return x;
+}
+
+Task<uint64_t> loopOfAwaits(const uint64_t n) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        sum += co_await identity(i);
+    }
+    co_return sum;
+}
+
+Task<uint64_t> depth(const uint64_t n) {
+    if (n == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await depth(n - 1);
+}
+
+// Without symmetric transfer each await that completes at once would nest
+// another resume() on the stack, and both of these would overflow it.
+void testSymmetricTransferUsesConstantStack() {
+#ifdef __OPTIMIZE__
+    constexpr uint64_t n = 1000000;
+#else
+    // GCC only turns the transfer into a tail call when optimizing.
+    constexpr uint64_t n = 10000;
+#endif
+    assert(syncWait(loopOfAwaits(n)) == n * (n - 1) / 2);
+    assert(syncWait(depth(n)) == n);
+}
+
+Task<std::thread::id> threadAfterSchedule(CoroutineExecutor& executor) {
+    co_await executor.schedule();
+    co_return std::this_thread::get_id();
+}
+
+void testScheduleMovesToPool() {
+    CoroutineExecutor executor(2);
+    assert(syncWait(threadAfterSchedule(executor)) != std::this_thread::get_id());
+}
+
+Task<int> squareOnPool(CoroutineExecutor& executor, const int i) {
+    co_await executor.schedule();
+    if (i < 0) {
+        throw std::invalid_argument("negative");
+    }
+    co_return i * i;
+}
+
+Task<void> countOnPool(CoroutineExecutor& executor, std::atomic<int>& counter) {
+    co_await executor.schedule();
+    ++counter;
+}
+
+void testWhenAll() {
+    CoroutineExecutor executor(4);
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 100; ++i) {
+        tasks.push_back(squareOnPool(executor, i));
+    }
+    const std::vector<int> squares = syncWait(when_all(std::move(tasks)));
+    assert(squares.size() == 100);
+    for (int i = 0; i < 100; ++i) {
+        assert(squares[i] == i * i);
+    }
+
+    std::atomic<int> counter{0};
+    std::vector<Task<void>> voids;
+    for (int i = 0; i < 50; ++i) {
+        voids.push_back(countOnPool(executor, counter));
+    }
+    syncWait(when_all(std::move(voids)));
+    assert(counter == 50);
+
+    assert(syncWait(when_all(std::vector<Task<int>>{})).empty());
+
+    std::vector<Task<int>> withFailure;
+    withFailure.push_back(squareOnPool(executor, 1));
+    withFailure.push_back(squareOnPool(executor, -1));
+    bool exception_caught = false;
+    try {
+        syncWait(when_all(std::move(withFailure)));
+    } catch (const std::invalid_argument&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+}
+
+Task<int> slowUnlessChosen(CoroutineExecutor& executor, const int i, const int chosen) {
+    co_await executor.schedule();
+    if (i != chosen) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    co_return i;
+}
+
+void testWhenAny() {
+    CoroutineExecutor executor(4);
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 4; ++i) {
+        tasks.push_back(slowUnlessChosen(executor, i, 2));
+    }
+    const auto [index, value] = syncWait(when_any(std::move(tasks)));
+    assert(index == 2 && value == 2);
+
+    bool exception_caught = false;
+    try {
+        syncWait(when_any(std::vector<Task<int>>{}));
+    } catch (const std::invalid_argument&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+    // The losers finish in the background before the executor is destroyed.
+}
+
+// Producers return the sum they pushed and consumers the sum they popped,
+// so one when_all can wait for both sides.
+Task<int64_t> produce(CoroutineExecutor& executor, AsyncQueue<int>& queue, const int first, const int count) {
+    co_await executor.schedule();
+    int64_t sum = 0;
+    for (int i = first; i < first + count; ++i) {
+        co_await queue.push(i);
+        sum += i;
+    }
+    co_return sum;
+}
+
+Task<int64_t> consume(CoroutineExecutor& executor, AsyncQueue<int>& queue, const int count, bool& ordered) {
+    co_await executor.schedule();
+    int64_t sum = 0;
+    int previous = -1;
+    for (int i = 0; i < count; ++i) {
+        const int value = co_await queue.pop();
+        ordered &= value > previous;
+        previous = value;
+        sum += value;
+    }
+    co_return sum;
+}
+
+void testAsyncQueueFifoWithBackpressure() {
+    CoroutineExecutor executor(2);
+    for (const size_t capacity : {0, 1, 4, 64}) {
+        AsyncQueue<int> queue(executor, capacity);
+        bool ordered = true;
+        std::vector<Task<int64_t>> sides;
+        sides.push_back(produce(executor, queue, 0, 20000));
+        sides.push_back(consume(executor, queue, 20000, ordered));
+        const std::vector<int64_t> sums = syncWait(when_all(std::move(sides)));
+        assert(sums[0] == sums[1]);
+        assert(ordered);
+    }
+}
+
+void testAsyncQueueManyToMany() {
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int perProducer = 10000;
+    CoroutineExecutor executor(4);
+    AsyncQueue<int> queue(executor, 8);
+    std::vector<Task<int64_t>> sides;
+    for (int p = 0; p < producers; ++p) {
+        sides.push_back(produce(executor, queue, p * perProducer, perProducer));
+    }
+    // Values from different producers interleave, so only the totals are
+    // checked, not the order flags.
+    std::array<bool, consumers> interleaved{};
+    for (int c = 0; c < consumers; ++c) {
+        sides.push_back(consume(executor, queue, perProducer, interleaved[c]));
+    }
+    const std::vector<int64_t> sums = syncWait(when_all(std::move(sides)));
+    int64_t pushed = 0;
+    int64_t popped = 0;
+    for (int i = 0; i < producers; ++i) pushed += sums[i];
+    for (int i = producers; i < producers + consumers; ++i) popped += sums[i];
+    assert(pushed == popped);
+    const int64_t n = producers * perProducer;
+    assert(pushed == n * (n - 1) / 2);
+}
+
+Task<void> ping(CoroutineExecutor& executor, AsyncQueue<int>& queue, const int items) {
+    co_await executor.schedule();
+    for (int i = 0; i < items; ++i) {
+        co_await queue.push(i);
+    }
+}
+
+Task<void> pong(CoroutineExecutor& executor, AsyncQueue<int>& queue, const int items, int64_t& sum) {
+    co_await executor.schedule();
+    for (int i = 0; i < items; ++i) {
+        sum += co_await queue.pop();
+    }
+}
+
+int64_t benchmarkSink = 0;
+
+double coroutineItemsPerSecond(const size_t workers, const size_t capacity, const int items) {
+    CoroutineExecutor executor(workers);
+    AsyncQueue<int> queue(executor, capacity);
+    int64_t sum = 0;
+    std::vector<Task<void>> sides;
+    sides.push_back(ping(executor, queue, items));
+    sides.push_back(pong(executor, queue, items, sum));
+    const auto start = std::chrono::steady_clock::now();
+    syncWait(when_all(std::move(sides)));
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink += sum;
+    return items / elapsed.count();
+}
+
+double threadItemsPerSecond(const size_t capacity, const int items) {
+    CondvarQueue<int> queue(capacity);
+    int64_t sum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::thread producer([&queue, items] {
+        for (int i = 0; i < items; ++i) queue.push(i);
+    });
+    for (int i = 0; i < items; ++i) sum += queue.pop();
+    producer.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink += sum;
+    return items / elapsed.count();
+}
+
+void benchmarkHandoff() {
+    constexpr int items = 1000000;
+    std::cout << "\nNanoseconds per item, one producer and one consumer ("
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    std::cout << "capacity\tthreads+condvar\tcoroutines, 1 worker\tcoroutines, 2 workers" << std::endl;
+    for (const size_t capacity : {1, 64}) {
+        std::cout << capacity << "\t\t" << 1e9 / threadItemsPerSecond(capacity, items / 10) << "\t\t"
+                  << 1e9 / coroutineItemsPerSecond(1, capacity, items) << "\t\t\t"
+                  << 1e9 / coroutineItemsPerSecond(2, capacity, items) << std::endl;
+    }
+}
+
+int main() {
+    test("Sync Wait Values And Exceptions", testSyncWaitValuesAndExceptions);
+    test("Symmetric Transfer Uses Constant Stack", testSymmetricTransferUsesConstantStack);
+    test("Schedule Moves To Pool", testScheduleMovesToPool);
+    test("When All", testWhenAll);
+    test("When Any", testWhenAny);
+    test("Async Queue FIFO With Backpressure", testAsyncQueueFifoWithBackpressure);
+    test("Async Queue Many To Many", testAsyncQueueManyToMany);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkHandoff();
+    return 0;
+}
@@ -0,0 +1,446 @@
+#ifndef CPP_DATASTRUCTURES_TASK_H
+#define CPP_DATASTRUCTURES_TASK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+template <typename T = void>
+class Task;
+
+namespace task_detail {
+
+struct PromiseBase {
+    // When the task finishes it transfers straight to whoever awaited it.
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+            return self.promise().continuation;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+
+    std::optional<T> value;
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void result() const {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+} // namespace task_detail
+
+/**
+ * @brief A lazily started coroutine that produces a T (or nothing).
+ *
+ * A Task does not run until it is awaited. co_await suspends the caller,
+ * records it as the task's continuation and transfers control into the task;
+ * when the task finishes, its final suspend transfers straight back. Both
+ * hops are symmetric transfers (await_suspend returns the next handle), so a
+ * long chain or loop of tasks that complete without suspending runs in
+ * constant stack space instead of nesting one resume() per await. (GCC
+ * emits the transfer as a tail call only in optimized builds; unoptimized,
+ * each level still takes some stack.)
+ *
+ * An exception escaping the coroutine is stored and rethrown from co_await.
+ * The Task owns the coroutine frame and destroys it with itself.
+ *
+ * To run a task from ordinary code, pass it to syncWait. To run it on a pool,
+ * start it with co_await executor.schedule() (see CoroutineExecutor).
+ *
+ * @tparam T The result type; void for none.
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = task_detail::Promise<T>;
+
+    Task(Task&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (_handle) {
+                _handle.destroy();
+            }
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task() {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    auto operator co_await() const& noexcept { return Awaiter{_handle}; }
+    auto operator co_await() const&& noexcept { return Awaiter{_handle}; }
+
+private:
+    friend promise_type;
+
+    struct Awaiter {
+        bool await_ready() const noexcept { return !handle || handle.done(); }
+
+        std::coroutine_handle<> await_suspend(const std::coroutine_handle<> caller) noexcept {
+            handle.promise().continuation = caller;
+            return handle;
+        }
+
+        T await_resume() {
+            if (!handle) {
+                throw std::logic_error("Awaited an empty Task.");
+            }
+            return handle.promise().result();
+        }
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    explicit Task(const std::coroutine_handle<promise_type> handle) noexcept : _handle(handle) {}
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+namespace task_detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief A coroutine that starts at once and frees its own frame when it
+ * ends, then transfers to the handle set with ContinueWith (if any). Used to
+ * run the children of syncWait, when_all and when_any.
+ */
+struct Detached {
+    struct promise_type {
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(const std::coroutine_handle<promise_type> self) noexcept {
+                const std::coroutine_handle<> next = self.promise().next;
+                self.destroy();
+                return next;
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+
+        std::coroutine_handle<> next = std::noop_coroutine();
+    };
+};
+
+/**
+ * @brief co_await ContinueWith{h} in a Detached coroutine makes it transfer
+ * to h when it ends. Does not suspend.
+ */
+struct ContinueWith {
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(const std::coroutine_handle<Detached::promise_type> self) const noexcept {
+        self.promise().next = next;
+        return false;
+    }
+
+    void await_resume() const noexcept {}
+
+    std::coroutine_handle<> next;
+};
+
+/**
+ * @brief Counts down the children of a combinator plus one for the parent
+ * while it starts them; whoever arrives last resumes the parent.
+ */
+struct Gate {
+    explicit Gate(const size_t count) : remaining(count) {}
+
+    std::coroutine_handle<> arrive() noexcept {
+        return remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 ? waiter : std::noop_coroutine();
+    }
+
+    std::atomic<size_t> remaining;
+    std::coroutine_handle<> waiter;
+};
+
+/**
+ * @brief Suspends the parent, runs start() to launch the children, and
+ * resumes at once if they all finished during start.
+ */
+template <typename Start>
+struct StartAndWait {
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(const std::coroutine_handle<> parent) {
+        gate.waiter = parent;
+        start();
+        return gate.arrive() != parent;
+    }
+
+    void await_resume() const noexcept {}
+
+    Gate& gate;
+    Start start;
+};
+
+template <typename T>
+using ValueOf = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+template <typename T>
+struct AllState {
+    explicit AllState(const size_t n) : gate(n + 1), values(n), errors(n) {}
+
+    Gate gate;
+    std::vector<std::optional<ValueOf<T>>> values;
+    std::vector<std::exception_ptr> errors;
+};
+
+template <typename T>
+Detached runAllChild(Task<T> task, AllState<T>& state, const size_t index) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            state.values[index].emplace();
+        } else {
+            state.values[index].emplace(co_await std::move(task));
+        }
+    } catch (...) {
+        state.errors[index] = std::current_exception();
+    }
+    co_await ContinueWith{state.gate.arrive()};
+}
+
+template <typename T>
+auto startAll(std::vector<Task<T>>& tasks, AllState<T>& state) {
+    auto start = [&tasks, &state] {
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            runAllChild(std::move(tasks[i]), state, i);
+        }
+    };
+    return StartAndWait<decltype(start)>{state.gate, start};
+}
+
+// Shared with the children, which may outlive the when_any that started them.
+template <typename T>
+struct AnyState {
+    // One arrival from the parent, one from the winner.
+    Gate gate{2};
+    std::atomic<bool> decided{false};
+    size_t index = 0;
+    std::optional<ValueOf<T>> value;
+    std::exception_ptr error;
+};
+
+template <typename T>
+Detached runAnyChild(Task<T> task, std::shared_ptr<AnyState<T>> state, const size_t index) {
+    std::optional<ValueOf<T>> value;
+    std::exception_ptr error;
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            value.emplace();
+        } else {
+            value.emplace(co_await std::move(task));
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    if (!state->decided.exchange(true, std::memory_order_acq_rel)) {
+        state->index = index;
+        state->value = std::move(value);
+        state->error = error;
+        co_await ContinueWith{state->gate.arrive()};
+    }
+}
+
+template <typename T>
+auto startAny(std::vector<Task<T>>& tasks, const std::shared_ptr<AnyState<T>>& state) {
+    auto start = [&tasks, &state] {
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            runAnyChild(std::move(tasks[i]), state, i);
+        }
+    };
+    return StartAndWait<decltype(start)>{state->gate, start};
+}
+
+} // namespace task_detail
+
+/**
+ * @brief Runs a task to completion from ordinary (non-coroutine) code and
+ * returns its result, blocking the calling thread until it finishes. The
+ * task may finish on another thread.
+ */
+template <typename T>
+T syncWait(Task<T> task) {
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    std::optional<task_detail::ValueOf<T>> value;
+    std::exception_ptr error;
+
+    [](Task<T> inner, std::mutex& m, std::condition_variable& cv, bool& flag, auto& out,
+       std::exception_ptr& err) -> task_detail::Detached {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                co_await std::move(inner);
+                out.emplace();
+            } else {
+                out.emplace(co_await std::move(inner));
+            }
+        } catch (...) {
+            err = std::current_exception();
+        }
+        // Notify under the lock so the waiter cannot return, and destroy
+        // these locals, before notify_one is done with them.
+        std::lock_guard<std::mutex> lock(m);
+        flag = true;
+        cv.notify_one();
+    }(std::move(task), mutex, finished, done, value, error);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&done] { return done; });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*value);
+    }
+}
+
+/**
+ * @brief Runs all the tasks concurrently and returns their results in
+ * order, once every one has finished.
+ *
+ * The tasks are started one after another on the awaiting thread; a task
+ * that first does co_await executor.schedule() moves to the pool, so the
+ * tasks run in parallel. If any task throws, the first exception (in task
+ * order) is rethrown after all have finished.
+ */
+template <typename T>
+Task<std::vector<T>> when_all(std::vector<Task<T>> tasks) {
+    task_detail::AllState<T> state(tasks.size());
+    co_await task_detail::startAll(tasks, state);
+    std::vector<T> results;
+    results.reserve(state.values.size());
+    for (size_t i = 0; i < state.values.size(); ++i) {
+        if (state.errors[i]) {
+            std::rethrow_exception(state.errors[i]);
+        }
+        results.push_back(std::move(*state.values[i]));
+    }
+    co_return results;
+}
+
+/**
+ * @brief Runs all the tasks concurrently and finishes when every one has.
+ * Rethrows the first exception in task order.
+ */
+inline Task<void> when_all(std::vector<Task<void>> tasks) {
+    task_detail::AllState<void> state(tasks.size());
+    co_await task_detail::startAll(tasks, state);
+    for (const auto& error : state.errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * @brief Runs all the tasks concurrently and returns as soon as one
+ * finishes, with its index and result (or its exception, rethrown).
+ *
+ * Coroutines cannot be cancelled from outside, so the other tasks keep
+ * running to completion in the background and their results are dropped;
+ * they must not refer to anything the caller may destroy.
+ *
+ * @throws std::invalid_argument if tasks is empty.
+ */
+template <typename T>
+Task<std::pair<size_t, T>> when_any(std::vector<Task<T>> tasks) {
+    if (tasks.empty()) {
+        throw std::invalid_argument("when_any needs at least one task.");
+    }
+    const auto state = std::make_shared<task_detail::AnyState<T>>();
+    co_await task_detail::startAny(tasks, state);
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+    co_return std::pair<size_t, T>(state->index, std::move(*state->value));
+}
+
+/**
+ * @brief Like when_any, for tasks without a result: returns the index of the
+ * first task to finish.
+ */
+inline Task<size_t> when_any(std::vector<Task<void>> tasks) {
+    if (tasks.empty()) {
+        throw std::invalid_argument("when_any needs at least one task.");
+    }
+    const auto state = std::make_shared<task_detail::AnyState<void>>();
+    co_await task_detail::startAny(tasks, state);
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+    co_return state->index;
+}
+
+#endif //CPP_DATASTRUCTURES_TASK_H
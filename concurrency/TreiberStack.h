@@ -0,0 +1,86 @@
+#ifndef CPP_DATASTRUCTURES_TREIBERSTACK_H
+#define CPP_DATASTRUCTURES_TREIBERSTACK_H
+
+#include "Reclamation.h"
+
+#include <atomic>
+#include <utility>
+
+/**
+ * @brief An unbounded lock-free stack (Treiber, 1986).
+ *
+ * push and pop swing the head pointer with a CAS. Popped nodes are retired
+ * through the Reclaimer instead of deleted, which also rules out the ABA
+ * problem: a node cannot be freed and its address reused while a thread
+ * that read it still holds a guard.
+ *
+ * @tparam T The element type; must be move constructible and move assignable.
+ * @tparam Reclaimer reclamation::Epoch or reclamation::HazardPointers.
+ */
+template <typename T, typename Reclaimer = reclamation::Epoch>
+class TreiberStack {
+private:
+    struct Node {
+        explicit Node(T v) : value(std::move(v)) {}
+
+        T value;
+        // Set before the node is published and never changed after.
+        Node* next = nullptr;
+    };
+
+public:
+    TreiberStack() = default;
+
+    /**
+     * @brief Deletes the remaining nodes. No other thread may be using the
+     * stack.
+     */
+    ~TreiberStack() {
+        Node* node = _head.load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            delete std::exchange(node, node->next);
+        }
+    }
+
+    TreiberStack(const TreiberStack&) = delete;
+    TreiberStack& operator=(const TreiberStack&) = delete;
+
+    void push(T value) {
+        auto* node = new Node(std::move(value));
+        node->next = _head.load(std::memory_order_relaxed);
+        while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Pops the most recently pushed element.
+     * @param out Receives the element.
+     * @return true if an element was popped; false if the stack was empty.
+     */
+    bool try_pop(T& out) {
+        typename Reclaimer::Guard guard;
+        while (true) {
+            Node* top = guard.protect(_head, 0);
+            if (top == nullptr) {
+                return false;
+            }
+            if (_head.compare_exchange_weak(top, top->next, std::memory_order_acquire, std::memory_order_relaxed)) {
+                out = std::move(top->value);
+                guard.retire(top);
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns whether the stack looked empty; may be stale by the time
+     * it returns.
+     */
+    bool empty() const { return _head.load(std::memory_order_relaxed) == nullptr; }
+
+private:
+    std::atomic<Node*> _head{nullptr};
+};
+
+#endif //CPP_DATASTRUCTURES_TREIBERSTACK_H
@@ -0,0 +1,306 @@
+#include "WorkStealingPool.h"
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+template <typename Pool>
+long long fib(Pool& pool, const int n) {
+    if (n < 2) {
+        return n;
+    }
+    long long left = 0;
+    auto handle = pool.fork([&pool, &left, n] { left = fib(pool, n - 1); });
+    const long long right = fib(pool, n - 2);
+    pool.join(handle);
+    return left + right;
+}
+
+void testRecursiveForkJoin() {
+    WorkStealingPool pool(4);
+    assert(fib(pool, 22) == 17711);
+    // Results come back through join, including from outside the pool.
+    auto handle = pool.fork([] { return 610; });
+    assert(pool.join(handle) == 610);
+}
+
+void testDeepForkJoinFromOutsideThePool() {
+    // Every fork from this thread goes to the injection queue. join must not
+    // run other injected tasks, or the nesting on this stack is unbounded.
+    // How deep it gets depends on how far the worker lags, so try a few times.
+    for (int round = 0; round < 5; ++round) {
+        WorkStealingPool pool(1);
+        assert(fib(pool, 27) == 196418);
+    }
+}
+
+void testExceptionsReachJoinAndFuture() {
+    WorkStealingPool pool(2);
+    auto handle = pool.fork([]() -> int { throw std::runtime_error("boom"); });
+    bool exception_caught = false;
+    try {
+        pool.join(handle);
+    } catch (const std::runtime_error&) {
+        exception_caught = true;
+    }
+    assert(exception_caught);
+
+    auto future = pool.submit([] { return std::string("done"); });
+    assert(future.get() == "done");
+}
+
+void testParallelForVisitsEachIndexOnce() {
+    WorkStealingPool pool(4);
+    std::vector<std::atomic<int>> visits(100003);
+    pool.parallel_for(0, visits.size(), [&visits](const size_t i) { ++visits[i]; });
+    assert(std::all_of(visits.begin(), visits.end(), [](const auto& v) { return v.load() == 1; }));
+
+    // Nested loops inside pool tasks.
+    std::atomic<long long> sum{0};
+    pool.parallel_for(0, 64, [&pool, &sum](const size_t i) {
+        pool.parallel_for(0, 1000, [&sum, i](const size_t j) { sum += static_cast<long long>(i * j); });
+    });
+    assert(sum == 63LL * 64 / 2 * (999LL * 1000 / 2));
+}
+
+void testParallelForWaitsForAllPiecesOnException() {
+    WorkStealingPool pool(4);
+    for (int round = 0; round < 20; ++round) {
+        // A piece still running after parallel_for returns would be calling a body that refers
+        // to this frame; entered and left show whether any call was still in flight.
+        std::atomic<int> entered{0}, left{0};
+        bool exception_caught = false;
+        try {
+            pool.parallel_for(0, 10000, [&entered, &left](const size_t i) {
+                ++entered;
+                if (i == 5000) {
+                    ++left;
+                    throw std::runtime_error("boom");
+                }
+                std::this_thread::yield();
+                ++left;
+            }, 16);
+        } catch (const std::runtime_error&) {
+            exception_caught = true;
+        }
+        assert(exception_caught);
+        const int enteredNow = entered.load();
+        assert(left.load() == enteredNow);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        assert(entered.load() == enteredNow);
+    }
+}
+
+void testSleepingWorkersWake() {
+    WorkStealingPool pool(3);
+    // Long enough for every worker to go to sleep.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::atomic<int> ran{0};
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 100; ++i) {
+        futures.push_back(pool.submit([&ran] { ++ran; }));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+    assert(ran == 100);
+}
+
+void testDestructorDrainsQueuedTasks() {
+    std::atomic<int> ran{0};
+    {
+        WorkStealingPool pool(2);
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&ran] { ++ran; });
+        }
+    }
+    assert(ran == 1000);
+}
+
+// The usual alternative: every task goes through one mutex-protected queue.
+// join helps by running queued tasks so it is deadlock-free like the
+// work-stealing pool, and the quicksort below can run on either.
+class SharedQueuePool {
+public:
+    explicit SharedQueuePool(const size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            _threads.emplace_back([this] {
+                while (true) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(_mtx);
+                        _cond_var.wait(lock, [this] { return _stop || !_tasks.empty(); });
+                        if (_tasks.empty()) return;
+                        task = std::move(_tasks.front());
+                        _tasks.pop_front();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~SharedQueuePool() {
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _stop = true;
+        }
+        _cond_var.notify_all();
+        for (auto& t : _threads) t.join();
+    }
+
+    using Handle = std::shared_ptr<std::atomic<bool>>;
+
+    template <typename F>
+    Handle fork(F fn) {
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _tasks.emplace_back([fn = std::move(fn), done]() mutable {
+                fn();
+                done->store(true, std::memory_order_release);
+            });
+        }
+        _cond_var.notify_one();
+        return done;
+    }
+
+    void join(const Handle& done) {
+        while (!done->load(std::memory_order_acquire)) {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                if (!_tasks.empty()) {
+                    task = std::move(_tasks.back());
+                    _tasks.pop_back();
+                }
+            }
+            if (task) {
+                task();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    std::mutex _mtx;
+    std::condition_variable _cond_var;
+    std::deque<std::function<void()>> _tasks;
+    std::vector<std::thread> _threads;
+    bool _stop = false;
+};
+
+template <typename Pool>
+void quicksort(Pool& pool, int* first, int* last, const ptrdiff_t cutoff) {
+    if (last - first <= cutoff) {
+        std::sort(first, last);
+        return;
+    }
+    const int a = *first, b = first[(last - first) / 2], c = *(last - 1);
+    const int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+    int* lessEnd = std::partition(first, last, [pivot](const int x) { return x < pivot; });
+    int* equalEnd = std::partition(lessEnd, last, [pivot](const int x) { return x == pivot; });
+    auto left = pool.fork([&pool, first, lessEnd, cutoff] { quicksort(pool, first, lessEnd, cutoff); });
+    quicksort(pool, equalEnd, last, cutoff);
+    pool.join(left);
+}
+
+void testParallelQuicksort() {
+    WorkStealingPool pool(4);
+    std::vector<int> data(200000);
+    std::mt19937 rng(3);
+    for (int& x : data) x = static_cast<int>(rng() % 1000);
+    quicksort(pool, data.data(), data.data() + data.size(), 64);
+    assert(std::is_sorted(data.begin(), data.end()));
+}
+
+template <typename Pool>
+double sortSeconds(const size_t threads, const std::vector<int>& input, const ptrdiff_t cutoff) {
+    Pool pool(threads);
+    std::vector<int> data = input;
+    const auto start = std::chrono::steady_clock::now();
+    quicksort(pool, data.data(), data.data() + data.size(), cutoff);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (!std::is_sorted(data.begin(), data.end())) {
+        throw std::runtime_error("quicksort produced unsorted output");
+    }
+    return elapsed.count();
+}
+
+void benchmarkQuicksort() {
+    std::vector<int> input(4000000);
+    std::mt19937 rng(11);
+    for (int& x : input) x = static_cast<int>(rng());
+
+    std::vector<int> serial = input;
+    const auto start = std::chrono::steady_clock::now();
+    std::sort(serial.begin(), serial.end());
+    const std::chrono::duration<double> serialTime = std::chrono::steady_clock::now() - start;
+
+    std::cout << "\nParallel quicksort of 4M ints (" << std::thread::hardware_concurrency()
+              << " hardware threads), std::sort: " << serialTime.count() << " s" << std::endl;
+    std::cout << "threads\tcutoff\tshared queue s\twork stealing s" << std::endl;
+    for (const size_t threads : {1, 2, 4, 8}) {
+        for (const ptrdiff_t cutoff : {256, 4096}) {
+            std::cout << threads << "\t" << cutoff << "\t"
+                      << sortSeconds<SharedQueuePool>(threads, input, cutoff) << "\t"
+                      << sortSeconds<WorkStealingPool>(threads, input, cutoff) << std::endl;
+        }
+    }
+}
+
+// One fork per call: almost all the time is task overhead.
+void benchmarkForkOverhead() {
+    constexpr int n = 27;
+    std::cout << "\nfib(" << n << ") with a fork per call" << std::endl;
+    std::cout << "threads\tshared queue s\twork stealing s" << std::endl;
+    for (const size_t threads : {1, 4}) {
+        auto time = [threads]<typename Pool>() {
+            Pool pool(threads);
+            const auto start = std::chrono::steady_clock::now();
+            if (fib(pool, n) != 196418) throw std::runtime_error("wrong fib");
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        std::cout << threads << "\t" << time.template operator()<SharedQueuePool>() << "\t"
+                  << time.template operator()<WorkStealingPool>() << std::endl;
+    }
+}
+
+int main() {
+    test("Recursive Fork Join", testRecursiveForkJoin);
+    test("Deep Fork Join From Outside The Pool", testDeepForkJoinFromOutsideThePool);
+    test("Exceptions Reach Join And Future", testExceptionsReachJoinAndFuture);
+    test("Parallel For Visits Each Index Once", testParallelForVisitsEachIndexOnce);
+    test("Parallel For Waits For All Pieces On Exception", testParallelForWaitsForAllPiecesOnException);
+    test("Sleeping Workers Wake", testSleepingWorkersWake);
+    test("Destructor Drains Queued Tasks", testDestructorDrainsQueuedTasks);
+    test("Parallel Quicksort", testParallelQuicksort);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkForkOverhead();
+    benchmarkQuicksort();
+    return 0;
+}
@@ -0,0 +1,479 @@
+#ifndef CPP_DATASTRUCTURES_WORKSTEALINGPOOL_H
+#define CPP_DATASTRUCTURES_WORKSTEALINGPOOL_H
+
+#include "ChaseLevDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief A fork/join thread pool with one Chase–Lev deque per worker.
+ *
+ * A task forked on a worker goes onto that worker's own deque, and the worker
+ * pops its newest task first, so recursive divide-and-conquer code runs
+ * depth-first and cache-hot on one core. A worker that runs out of work
+ * steals the oldest task from a random victim, which is usually the biggest
+ * remaining piece. Tasks submitted from outside the pool go to a shared
+ * injection queue.
+ *
+ * join never blocks a worker: while the joined task is unfinished the worker
+ * runs other tasks, so deep fork/join recursion cannot deadlock the pool. A
+ * thread outside the pool runs only the task it joins, if no worker has taken
+ * it yet, and otherwise waits: helping with arbitrary injected tasks, each of
+ * which may fork and join again, would nest on its stack without bound.
+ * Workers that find nothing to do spin briefly and then sleep on a condition
+ * variable; forking only touches the lock when some worker is asleep.
+ */
+class WorkStealingPool {
+private:
+    class Task {
+    public:
+        explicit Task(const int references) : _references(references) {}
+        virtual ~Task() = default;
+        virtual void run() = 0;
+
+        void release() {
+            if (_references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+
+    private:
+        std::atomic<int> _references;
+    };
+
+    template <typename R>
+    class ResultTask : public Task {
+    public:
+        using Task::Task;
+
+        bool done() const { return _done.load(std::memory_order_acquire); }
+
+        R take() {
+            if (_error) {
+                std::rethrow_exception(_error);
+            }
+            if constexpr (!std::is_void_v<R>) {
+                return std::move(std::get<1>(_result));
+            }
+        }
+
+    protected:
+        template <typename F>
+        void complete(F& fn) {
+            try {
+                if constexpr (std::is_void_v<R>) {
+                    fn();
+                } else {
+                    _result.template emplace<1>(fn());
+                }
+            } catch (...) {
+                _error = std::current_exception();
+            }
+            _done.store(true, std::memory_order_release);
+        }
+
+    private:
+        std::variant<std::monostate, std::conditional_t<std::is_void_v<R>, std::monostate, R>> _result;
+        std::exception_ptr _error;
+        std::atomic<bool> _done{false};
+    };
+
+    template <typename F, typename R>
+    class FnTask final : public ResultTask<R> {
+    public:
+        FnTask(F fn, const int references) : ResultTask<R>(references), _fn(std::move(fn)) {}
+        void run() override { this->complete(_fn); }
+
+    private:
+        F _fn;
+    };
+
+    // Fire-and-forget: nothing waits for it, so an exception terminates, as
+    // it would on a std::thread.
+    template <typename F>
+    class PostTask final : public Task {
+    public:
+        explicit PostTask(F fn) : Task(1), _fn(std::move(fn)) {}
+        void run() noexcept override { _fn(); }
+
+    private:
+        F _fn;
+    };
+
+public:
+    /**
+     * @brief The result of fork; pass it to join to wait for the task.
+     */
+    template <typename R>
+    class ForkHandle {
+    public:
+        ForkHandle(ForkHandle&& other) noexcept : _task(std::exchange(other._task, nullptr)) {}
+        ForkHandle& operator=(ForkHandle&& other) noexcept {
+            std::swap(_task, other._task);
+            return *this;
+        }
+        ~ForkHandle() {
+            if (_task) {
+                _task->release();
+            }
+        }
+
+        /**
+         * @brief Returns whether the task has finished.
+         */
+        bool ready() const { return _task->done(); }
+
+    private:
+        friend class WorkStealingPool;
+        explicit ForkHandle(ResultTask<R>* task) : _task(task) {}
+
+        ResultTask<R>* _task;
+    };
+
+    /**
+     * @brief Starts the workers.
+     * @param threads Number of workers; 0 means one per hardware thread.
+     */
+    explicit WorkStealingPool(size_t threads = 0) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            _workers.push_back(std::make_unique<Worker>());
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            _workers[i]->thread = std::thread([this, i] { workerLoop(i); });
+        }
+    }
+
+    /**
+     * @brief Runs every task still queued, then stops and joins the workers.
+     */
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _stop = true;
+            ++_epoch;
+        }
+        _wake.notify_all();
+        for (auto& worker : _workers) {
+            worker->thread.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Schedules fn to run on the pool, for waiting on with join.
+     *
+     * Called from a worker, the task goes onto that worker's deque; from any
+     * other thread, onto the injection queue.
+     */
+    template <typename F>
+    auto fork(F fn) -> ForkHandle<std::invoke_result_t<F&>> {
+        using R = std::invoke_result_t<F&>;
+        // One reference for the queue, one for the handle.
+        auto* task = new FnTask<F, R>(std::move(fn), 2);
+        schedule(task);
+        return ForkHandle<R>(task);
+    }
+
+    /**
+     * @brief Waits for a forked task and returns its result. On a worker, runs
+     * other tasks in the meantime; elsewhere, runs at most the joined task
+     * itself. Rethrows the task's exception, if any.
+     */
+    template <typename R>
+    R join(ForkHandle<R>& handle) {
+        ResultTask<R>* task = handle._task;
+        if (context().pool != this && takeInjected(task)) {
+            task->run();
+            task->release();
+        }
+        const bool isWorker = context().pool == this;
+        unsigned idle = 0;
+        while (!task->done()) {
+            if (isWorker && runOne()) {
+                idle = 0;
+            } else if (++idle > kSpinsBeforeYield) {
+                std::this_thread::yield();
+            }
+        }
+        return task->take();
+    }
+
+    template <typename R>
+    R join(ForkHandle<R>&& handle) {
+        return join(handle);
+    }
+
+    /**
+     * @brief Schedules fn from any thread and returns a std::future for it.
+     *
+     * Meant for callers outside the pool; a task running on the pool should
+     * use fork and join instead of blocking on the future.
+     */
+    template <typename F>
+    auto submit(F fn) -> std::future<std::invoke_result_t<F&>> {
+        using R = std::invoke_result_t<F&>;
+        std::packaged_task<R()> packaged(std::move(fn));
+        auto future = packaged.get_future();
+        auto run = [packaged = std::move(packaged)]() mutable { packaged(); };
+        schedule(new FnTask<decltype(run), void>(std::move(run), 1));
+        return future;
+    }
+
+    /**
+     * @brief Schedules fn with nothing to wait on: the cheapest way to run
+     * something on the pool. An exception escaping fn calls std::terminate.
+     */
+    template <typename F>
+    void post(F fn) {
+        schedule(new PostTask<F>(std::move(fn)));
+    }
+
+    /**
+     * @brief Calls body(i) for every i in [begin, end) in parallel and waits.
+     *
+     * The range is split in halves by fork/join until pieces reach the grain
+     * size. The automatic grain gives each worker about eight pieces, enough
+     * for stealing to even out uneven iterations without paying a fork per
+     * index.
+     *
+     * If body throws, the piece that threw stops, the other pieces still run
+     * to completion, and the first exception is rethrown once all are done.
+     *
+     * @param grain Largest piece run without splitting; 0 chooses automatically.
+     */
+    template <typename Body>
+    void parallel_for(const size_t begin, const size_t end, const Body& body, size_t grain = 0) {
+        if (begin >= end) {
+            return;
+        }
+        if (grain == 0) {
+            grain = std::max<size_t>(1, (end - begin) / (8 * _workers.size()));
+        }
+        parallelForRange(begin, end, body, grain);
+    }
+
+    /**
+     * @brief Returns the number of worker threads.
+     */
+    size_t size() const { return _workers.size(); }
+
+private:
+    static constexpr unsigned kSpinsBeforeYield = 64;
+    static constexpr unsigned kIdleRoundsBeforeSleep = 32;
+
+    struct Worker {
+        ChaseLevDeque<Task*> deque;
+        std::thread thread;
+    };
+
+    // Identifies the pool and worker the current thread belongs to, if any.
+    struct WorkerContext {
+        WorkStealingPool* pool = nullptr;
+        size_t index = 0;
+        uint64_t rng = 0x9E3779B97F4A7C15ull;
+    };
+
+    static WorkerContext& context() {
+        thread_local WorkerContext current;
+        return current;
+    }
+
+    template <typename Body>
+    void parallelForRange(const size_t begin, size_t end, const Body& body, const size_t grain) {
+        // The forked halves refer to body and to this frame's caller, so every one of them is
+        // joined before leaving, whatever throws. Room for all of them is reserved up front so
+        // that no allocation can fail between a fork and storing its handle.
+        std::vector<ForkHandle<void>> halves;
+        size_t pieces = 0;
+        for (size_t length = end - begin; length > grain; length /= 2) {
+            ++pieces;
+        }
+        halves.reserve(pieces);
+        std::exception_ptr error;
+        try {
+            while (end - begin > grain) {
+                const size_t mid = begin + (end - begin) / 2;
+                halves.push_back(fork([this, mid, end, &body, grain] { parallelForRange(mid, end, body, grain); }));
+                end = mid;
+            }
+            for (size_t i = begin; i < end; ++i) {
+                body(i);
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (auto it = halves.rbegin(); it != halves.rend(); ++it) {
+            try {
+                join(*it);
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void schedule(Task* task) {
+        WorkerContext& ctx = context();
+        if (ctx.pool == this) {
+            _workers[ctx.index]->deque.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(_injectionMutex);
+            _injection.push_back(task);
+            _injectionSize.fetch_add(1, std::memory_order_relaxed);
+        }
+        // Pairs with the sleeper count increment in workerLoop: either we see
+        // the sleeper, or the sleeper's final scan sees this task.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_sleepers.load(std::memory_order_relaxed) > 0) {
+            {
+                std::lock_guard<std::mutex> lock(_sleepMutex);
+                ++_epoch;
+            }
+            _wake.notify_one();
+        }
+    }
+
+    Task* takeInjected() {
+        if (_injectionSize.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(_injectionMutex);
+        if (_injection.empty()) {
+            return nullptr;
+        }
+        Task* task = _injection.front();
+        _injection.pop_front();
+        _injectionSize.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    // Removes one particular task from the injection queue; false if a worker
+    // has already taken it. Searches from the back, where a task just forked
+    // from outside the pool sits.
+    bool takeInjected(Task* wanted) {
+        std::lock_guard<std::mutex> lock(_injectionMutex);
+        const auto it = std::find(_injection.rbegin(), _injection.rend(), wanted);
+        if (it == _injection.rend()) {
+            return false;
+        }
+        _injection.erase(std::next(it).base());
+        _injectionSize.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    Task* findWork() {
+        WorkerContext& ctx = context();
+        const bool isWorker = ctx.pool == this;
+        if (isWorker) {
+            if (auto task = _workers[ctx.index]->deque.pop()) {
+                return *task;
+            }
+        }
+        if (Task* task = takeInjected()) {
+            return task;
+        }
+        // xorshift64 picks where the steal sweep starts.
+        ctx.rng ^= ctx.rng << 13;
+        ctx.rng ^= ctx.rng >> 7;
+        ctx.rng ^= ctx.rng << 17;
+        const size_t n = _workers.size();
+        const size_t start = ctx.rng % n;
+        for (size_t k = 0; k < n; ++k) {
+            const size_t victim = (start + k) % n;
+            if (isWorker && victim == ctx.index) {
+                continue;
+            }
+            if (auto task = _workers[victim]->deque.steal()) {
+                return *task;
+            }
+        }
+        return nullptr;
+    }
+
+    bool runOne() {
+        Task* task = findWork();
+        if (!task) {
+            return false;
+        }
+        task->run();
+        task->release();
+        return true;
+    }
+
+    bool anyWorkVisible() const {
+        if (_injectionSize.load(std::memory_order_relaxed) > 0) {
+            return true;
+        }
+        return std::any_of(_workers.begin(), _workers.end(), [](const auto& w) { return !w->deque.empty(); });
+    }
+
+    void workerLoop(const size_t index) {
+        context() = WorkerContext{this, index, 0x9E3779B97F4A7C15ull * (index + 1)};
+        unsigned idleRounds = 0;
+        while (true) {
+            if (runOne()) {
+                idleRounds = 0;
+                continue;
+            }
+            if (++idleRounds < kIdleRoundsBeforeSleep) {
+                std::this_thread::yield();
+                continue;
+            }
+            idleRounds = 0;
+
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (anyWorkVisible()) {
+                _sleepers.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (_stop) {
+                _sleepers.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            const uint64_t epoch = _epoch;
+            _wake.wait(lock, [this, epoch] { return _epoch != epoch; });
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    std::mutex _injectionMutex;
+    std::deque<Task*> _injection;
+    std::atomic<size_t> _injectionSize{0};
+
+    // Sleeping workers wait for _epoch to change; both guarded by _sleepMutex.
+    std::mutex _sleepMutex;
+    std::condition_variable _wake;
+    uint64_t _epoch = 0;
+    bool _stop = false;
+    std::atomic<int> _sleepers{0};
+};
+
+#endif //CPP_DATASTRUCTURES_WORKSTEALINGPOOL_H
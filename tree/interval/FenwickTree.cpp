@@ -0,0 +1,272 @@
+#include "FenwickTree.h"
+#include "SegmentTree.h"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testSmallExample() {
+    std::vector<long long> values = {5, -2, 7, 1, 3};
+    FenwickTree<long long> tree(values);
+    assert(tree.size() == 5);
+    assert(tree.rangeSum(0, 4) == 14);
+    assert(tree.rangeSum(1, 3) == 6);
+    assert(tree.prefixSum(0) == 0);
+    tree.pointUpdate(4, -10);
+    assert(tree.rangeSum(4, 4) == -7);
+    assert(tree.prefixSum(5) == 4);
+
+    RangeUpdateFenwickTree<long long> points(values);
+    points.rangeUpdate(1, 3, 10);
+    assert(points.pointQuery(0) == 5);
+    assert(points.pointQuery(1) == 8);
+    assert(points.pointQuery(3) == 11);
+    assert(points.pointQuery(4) == 3);
+
+    RangeUpdateRangeQueryFenwickTree<long long> ranges(values);
+    ranges.rangeUpdate(1, 3, 10);
+    assert(ranges.rangeSum(0, 4) == 44);
+    assert(ranges.rangeSum(3, 4) == 14);
+    ranges.pointUpdate(4, -10);
+    assert(ranges.rangeSum(4, 4) == -7);
+}
+
+const std::vector<int> sizes = {1, 2, 3, 5, 8, 15, 16, 17, 31, 64, 100, 257, 1000};
+
+std::vector<long long> randomValues(const int n, std::mt19937& rng) {
+    std::vector<long long> values(n);
+    for (auto& v : values) v = static_cast<long long>(rng() % 2001) - 1000;
+    return values;
+}
+
+void testPointUpdateRangeQuery() {
+    std::mt19937 rng(7);
+    for (const int n : sizes) {
+        std::vector<long long> naive = randomValues(n, rng);
+        FenwickTree<long long> tree(naive);
+        std::uniform_int_distribution<int> index(0, n - 1);
+        for (int step = 0; step < 3000; ++step) {
+            int lo = index(rng), hi = index(rng);
+            if (lo > hi) std::swap(lo, hi);
+            if (rng() % 3 == 0) {
+                const long long delta = static_cast<long long>(rng() % 201) - 100;
+                tree.pointUpdate(lo, delta);
+                naive[lo] += delta;
+            } else {
+                assert(tree.rangeSum(lo, hi) == std::accumulate(naive.begin() + lo, naive.begin() + hi + 1, 0LL));
+            }
+        }
+        assert(tree.prefixSum(n) == std::accumulate(naive.begin(), naive.end(), 0LL));
+    }
+}
+
+void testRangeUpdatePointQuery() {
+    std::mt19937 rng(8);
+    for (const int n : sizes) {
+        std::vector<long long> naive = randomValues(n, rng);
+        RangeUpdateFenwickTree<long long> tree(naive);
+        std::uniform_int_distribution<int> index(0, n - 1);
+        for (int step = 0; step < 3000; ++step) {
+            int lo = index(rng), hi = index(rng);
+            if (lo > hi) std::swap(lo, hi);
+            if (rng() % 3 == 0) {
+                const long long delta = static_cast<long long>(rng() % 201) - 100;
+                tree.rangeUpdate(lo, hi, delta);
+                for (int i = lo; i <= hi; ++i) naive[i] += delta;
+            } else {
+                assert(tree.pointQuery(lo) == naive[lo]);
+            }
+        }
+    }
+}
+
+void testRangeUpdateRangeQuery() {
+    std::mt19937 rng(9);
+    for (const int n : sizes) {
+        std::vector<long long> naive = randomValues(n, rng);
+        RangeUpdateRangeQueryFenwickTree<long long> tree(naive);
+        std::uniform_int_distribution<int> index(0, n - 1);
+        for (int step = 0; step < 3000; ++step) {
+            int lo = index(rng), hi = index(rng);
+            if (lo > hi) std::swap(lo, hi);
+            const long long delta = static_cast<long long>(rng() % 201) - 100;
+            switch (rng() % 3) {
+                case 0:
+                    tree.rangeUpdate(lo, hi, delta);
+                    for (int i = lo; i <= hi; ++i) naive[i] += delta;
+                    break;
+                case 1:
+                    tree.pointUpdate(lo, delta);
+                    naive[lo] += delta;
+                    break;
+                default:
+                    assert(tree.rangeSum(lo, hi) ==
+                           std::accumulate(naive.begin() + lo, naive.begin() + hi + 1, 0LL));
+                    break;
+            }
+        }
+    }
+}
+
+void testLowerBound() {
+    std::vector<int> values = {3, 0, 2, 5, 0, 1};
+    FenwickTree<int> tree(values);
+    assert(tree.lowerBound(0) == 0);
+    assert(tree.lowerBound(3) == 0);
+    assert(tree.lowerBound(4) == 2);
+    assert(tree.lowerBound(5) == 2);
+    assert(tree.lowerBound(6) == 3);
+    assert(tree.lowerBound(10) == 3);
+    assert(tree.lowerBound(11) == 5);
+    assert(tree.lowerBound(12) == 6);
+
+    // Against a binary search over the prefix sums, including after updates.
+    std::mt19937 rng(10);
+    for (const int n : sizes) {
+        std::vector<long long> naive(n);
+        for (auto& v : naive) v = static_cast<long long>(rng() % 10);
+        FenwickTree<long long> weights(naive);
+        for (int step = 0; step < 500; ++step) {
+            const int idx = static_cast<int>(rng() % n);
+            weights.pointUpdate(idx, 3);
+            naive[idx] += 3;
+            std::vector<long long> prefix(n);
+            std::partial_sum(naive.begin(), naive.end(), prefix.begin());
+            const long long target = static_cast<long long>(rng() % (prefix.back() + 2));
+            const size_t expected = std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin();
+            assert(weights.lowerBound(target) == expected);
+        }
+    }
+}
+
+void testQueriesAreConst() {
+    std::vector<int> values = {4, 2, 9};
+    const FenwickTree<int> tree(values);
+    assert(tree.rangeSum(0, 2) == 15);
+    assert(tree.lowerBound(7) == 2);
+    const RangeUpdateFenwickTree<int> points(values);
+    assert(points.pointQuery(2) == 9);
+    const RangeUpdateRangeQueryFenwickTree<int> ranges(values);
+    assert(ranges.rangeSum(1, 2) == 11);
+}
+
+volatile long long benchmarkSink = 0;
+
+struct Operation {
+    int lo, hi;
+    bool update;
+};
+
+template <typename Update, typename Query>
+double millionOpsPerSecond(const std::vector<Operation>& operations, Update update, Query query) {
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const Operation& op : operations) {
+        if (op.update) {
+            update(op.lo, op.hi);
+        } else {
+            sink += query(op.lo, op.hi);
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink = benchmarkSink + sink;
+    return operations.size() / elapsed.count() / 1e6;
+}
+
+// Bytes SegmentTree holds per element: a copy of the elements plus two arrays of 64-byte nodes,
+// one per inner node of a tree of branching 4 over the blocks of 16, and node 0.
+double segmentTreeBytesPerElement(const int n) {
+    long long leaves = 1;
+    while (leaves < (n + 15) / 16) leaves *= 4;
+    const double nodes = 2.0 * ((leaves + 2) / 3);
+    return (n * sizeof(long long) + nodes * 64) / n;
+}
+
+// The same operations run against SegmentTree and the matching Fenwick tree, half updates and
+// half queries on random ranges.
+void benchmarkAgainstSegmentTree(const int n) {
+    constexpr int count = 2000000;
+    std::mt19937 rng(42);
+    std::vector<long long> values(n);
+    for (auto& v : values) v = static_cast<long long>(rng() % 1000000);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    std::vector<Operation> operations(count);
+    for (auto& op : operations) {
+        op.lo = index(rng);
+        op.hi = index(rng);
+        if (op.lo > op.hi) std::swap(op.lo, op.hi);
+        op.update = rng() % 2 == 0;
+    }
+
+    std::cout << "\nMillion operations per second, n = " << n << ", 50% updates / 50% queries" << std::endl;
+    std::cout << "workload\t\t\tSegmentTree\tFenwick\t\tspeedup\tbytes/element" << std::endl;
+    const double segmentBytes = segmentTreeBytesPerElement(n);
+    double segment, fenwick;
+    {
+        SegmentTree<long long> tree(values);
+        segment = millionOpsPerSecond(operations, [&](int lo, int) { tree.pointUpdate(lo, 1); },
+                                      [&](int lo, int hi) { return tree.rangeSum(lo, hi); });
+    }
+    {
+        FenwickTree<long long> tree(values);
+        fenwick = millionOpsPerSecond(operations, [&](int lo, int) { tree.pointUpdate(lo, 1); },
+                                      [&](int lo, int hi) { return tree.rangeSum(lo, hi); });
+    }
+    std::cout << "pointUpdate + rangeSum\t\t" << segment << "\t\t" << fenwick << "\t\t" << fenwick / segment << "x\t"
+              << segmentBytes << " vs " << sizeof(long long) << std::endl;
+    {
+        SegmentTree<long long> tree(values);
+        segment = millionOpsPerSecond(operations, [&](int lo, int hi) { tree.rangeUpdate(lo, hi, 1); },
+                                      [&](int lo, int) { return tree.rangeSum(lo, lo); });
+    }
+    {
+        RangeUpdateFenwickTree<long long> tree(values);
+        fenwick = millionOpsPerSecond(operations, [&](int lo, int hi) { tree.rangeUpdate(lo, hi, 1); },
+                                      [&](int lo, int) { return tree.pointQuery(lo); });
+    }
+    std::cout << "rangeUpdate + point query\t" << segment << "\t\t" << fenwick << "\t\t" << fenwick / segment << "x\t"
+              << segmentBytes << " vs " << sizeof(long long) << std::endl;
+    {
+        SegmentTree<long long> tree(values);
+        segment = millionOpsPerSecond(operations, [&](int lo, int hi) { tree.rangeUpdate(lo, hi, 1); },
+                                      [&](int lo, int hi) { return tree.rangeSum(lo, hi); });
+    }
+    {
+        RangeUpdateRangeQueryFenwickTree<long long> tree(values);
+        fenwick = millionOpsPerSecond(operations, [&](int lo, int hi) { tree.rangeUpdate(lo, hi, 1); },
+                                      [&](int lo, int hi) { return tree.rangeSum(lo, hi); });
+    }
+    std::cout << "rangeUpdate + rangeSum\t\t" << segment << "\t\t" << fenwick << "\t\t" << fenwick / segment << "x\t"
+              << segmentBytes << " vs " << 2 * sizeof(long long) << std::endl;
+}
+
+int main() {
+    test("Small Example", testSmallExample);
+    test("Point Update Range Query", testPointUpdateRangeQuery);
+    test("Range Update Point Query", testRangeUpdatePointQuery);
+    test("Range Update Range Query", testRangeUpdateRangeQuery);
+    test("Lower Bound", testLowerBound);
+    test("Queries Are Const", testQueriesAreConst);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkAgainstSegmentTree(100000);
+    benchmarkAgainstSegmentTree(10000000);
+    return 0;
+}
@@ -0,0 +1,240 @@
+#ifndef CPP_DATASTRUCTURES_FENWICKTREE_H
+#define CPP_DATASTRUCTURES_FENWICKTREE_H
+
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief A Fenwick tree (binary indexed tree) for point updates and range sums.
+ *
+ * tree[i], for i from 1 to N, holds the sum of the lowbit(i) elements ending at element i - 1,
+ * where lowbit(i) is the lowest set bit of i. A prefix sum adds the entries met while clearing
+ * the low bits of its end one at a time, and an update adds to the entries met while adding
+ * the low bit, so both are O(log N) with one entry read or written per step. The tree is the
+ * N + 1 entries and nothing else: no copy of the elements, no padding to a power of two and
+ * no second aggregate, which makes it a fraction of the size of a SegmentTree and a better fit
+ * for code that only adds to single elements and sums ranges.
+ * @tparam T The element type; any type with +, - and a zero value T(0).
+ */
+template <typename T = long long>
+class FenwickTree {
+public:
+    /**
+     * @brief Builds the tree over values in place, pushing each entry into its parent once.
+     * Time Complexity: O(N)
+     */
+    explicit FenwickTree(const std::vector<T>& values) : _tree(values.size() + 1, T(0)) {
+        for (size_t i = 1; i < _tree.size(); ++i) {
+            _tree[i] += values[i - 1];
+            const size_t parent = i + (i & -i);
+            if (parent < _tree.size()) {
+                _tree[parent] += _tree[i];
+            }
+        }
+    }
+
+    /**
+     * @brief Sum of the first count elements.
+     * Time Complexity: O(log N)
+     */
+    T prefixSum(size_t count) const {
+        T sum = T(0);
+        for (; count > 0; count &= count - 1) {
+            sum += _tree[count];
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Sum of the elements in [qlow, qhigh].
+     * Time Complexity: O(log N)
+     */
+    T rangeSum(int qlow, int qhigh) const {
+        // The two prefix walks share every entry below the highest bit where their ends differ,
+        // so each side stops once it drops below the other.
+        size_t end = static_cast<size_t>(qhigh) + 1;
+        size_t first = static_cast<size_t>(qlow);
+        T sum = T(0);
+        for (; end > first; end &= end - 1) {
+            sum += _tree[end];
+        }
+        for (; first > end; first &= first - 1) {
+            sum -= _tree[first];
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Adds delta to the element at idx.
+     * Time Complexity: O(log N)
+     */
+    void pointUpdate(int idx, T delta) {
+        for (size_t i = static_cast<size_t>(idx) + 1; i < _tree.size(); i += i & -i) {
+            _tree[i] += delta;
+        }
+    }
+
+    /**
+     * @brief Finds the first index whose prefix sum reaches target, for non-negative elements.
+     * Descends the implicit tree from the largest power of two, like a binary search over the
+     * prefix sums but with one entry read per step.
+     * Time Complexity: O(log N)
+     * @return The smallest i with prefixSum(i + 1) >= target, or size() if there is none.
+     */
+    size_t lowerBound(T target) const {
+        size_t pos = 0;
+        for (size_t step = std::bit_floor(size()); step > 0; step >>= 1) {
+            if (pos + step < _tree.size() && _tree[pos + step] < target) {
+                pos += step;
+                target -= _tree[pos];
+            }
+        }
+        return pos;
+    }
+
+    size_t size() const { return _tree.size() - 1; }
+
+private:
+    // 1-based; _tree[0] is unused.
+    std::vector<T> _tree;
+};
+
+/**
+ * @brief A Fenwick tree for range updates and point queries.
+ *
+ * Keeps a FenwickTree over the differences d[i] = a[i] - a[i - 1]. Adding delta to [qlow, qhigh]
+ * changes only d[qlow] and d[qhigh + 1], and a[i] is the prefix sum of d up to i.
+ * @tparam T The element type.
+ */
+template <typename T = long long>
+class RangeUpdateFenwickTree {
+public:
+    /**
+     * Time Complexity: O(N)
+     */
+    explicit RangeUpdateFenwickTree(const std::vector<T>& values) : _differences(differencesOf(values)) {}
+
+    /**
+     * @brief Adds delta to every element in [qlow, qhigh].
+     * Time Complexity: O(log N)
+     */
+    void rangeUpdate(int qlow, int qhigh, T delta) {
+        _differences.pointUpdate(qlow, delta);
+        if (static_cast<size_t>(qhigh) + 1 < size()) {
+            _differences.pointUpdate(qhigh + 1, T(0) - delta);
+        }
+    }
+
+    /**
+     * @brief The current value of the element at idx.
+     * Time Complexity: O(log N)
+     */
+    T pointQuery(int idx) const {
+        return _differences.prefixSum(static_cast<size_t>(idx) + 1);
+    }
+
+    size_t size() const { return _differences.size(); }
+
+private:
+    static FenwickTree<T> differencesOf(const std::vector<T>& values) {
+        std::vector<T> differences(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            differences[i] = i == 0 ? values[0] : values[i] - values[i - 1];
+        }
+        return FenwickTree<T>(differences);
+    }
+
+    FenwickTree<T> _differences;
+};
+
+/**
+ * @brief A Fenwick tree for range updates and range sums.
+ *
+ * With d the differences of the elements, the sum of the first p elements is
+ *   sum over i < p of d[i] * (p - i) = p * sum(d[i]) - sum(i * d[i]),
+ * so the tree keeps Fenwick sums of d[i] and of i * d[i]. A range update changes two
+ * differences, and a prefix sum reads both sums. The two are stored side by side in one entry,
+ * so each step of a walk touches one cache line rather than one in each of two arrays.
+ * @tparam T The element type; it also needs * and a conversion from the element count.
+ */
+template <typename T = long long>
+class RangeUpdateRangeQueryFenwickTree {
+public:
+    /**
+     * Time Complexity: O(N)
+     */
+    explicit RangeUpdateRangeQueryFenwickTree(const std::vector<T>& values) : _tree(values.size() + 1) {
+        for (size_t i = 1; i < _tree.size(); ++i) {
+            const T difference = i == 1 ? values[0] : values[i - 1] - values[i - 2];
+            _tree[i].differences += difference;
+            _tree[i].weighted += difference * static_cast<T>(i - 1);
+            const size_t parent = i + (i & -i);
+            if (parent < _tree.size()) {
+                _tree[parent].differences += _tree[i].differences;
+                _tree[parent].weighted += _tree[i].weighted;
+            }
+        }
+    }
+
+    /**
+     * @brief Sum of the first count elements.
+     * Time Complexity: O(log N)
+     */
+    T prefixSum(size_t count) const {
+        T differences = T(0), weighted = T(0);
+        for (size_t i = count; i > 0; i &= i - 1) {
+            differences += _tree[i].differences;
+            weighted += _tree[i].weighted;
+        }
+        return differences * static_cast<T>(count) - weighted;
+    }
+
+    /**
+     * @brief Sum of the elements in [qlow, qhigh].
+     * Time Complexity: O(log N)
+     */
+    T rangeSum(int qlow, int qhigh) const {
+        return prefixSum(static_cast<size_t>(qhigh) + 1) - prefixSum(static_cast<size_t>(qlow));
+    }
+
+    /**
+     * @brief Adds delta to every element in [qlow, qhigh].
+     * Time Complexity: O(log N)
+     */
+    void rangeUpdate(int qlow, int qhigh, T delta) {
+        addToDifference(static_cast<size_t>(qlow), delta);
+        if (static_cast<size_t>(qhigh) + 1 < size()) {
+            addToDifference(static_cast<size_t>(qhigh) + 1, T(0) - delta);
+        }
+    }
+
+    /**
+     * @brief Adds delta to the element at idx.
+     * Time Complexity: O(log N)
+     */
+    void pointUpdate(int idx, T delta) {
+        rangeUpdate(idx, idx, delta);
+    }
+
+    size_t size() const { return _tree.size() - 1; }
+
+private:
+    struct Entry {
+        T differences = T(0);
+        T weighted = T(0);
+    };
+
+    void addToDifference(size_t idx, T delta) {
+        const T weighted = delta * static_cast<T>(idx);
+        for (size_t i = idx + 1; i < _tree.size(); i += i & -i) {
+            _tree[i].differences += delta;
+            _tree[i].weighted += weighted;
+        }
+    }
+
+    // 1-based; _tree[0] is unused.
+    std::vector<Entry> _tree;
+};
+
+#endif //CPP_DATASTRUCTURES_FENWICKTREE_H
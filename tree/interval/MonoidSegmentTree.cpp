@@ -0,0 +1,267 @@
+#include "MonoidSegmentTree.h"
+#include "RecursiveSegmentTree.h"
+#include "SegmentTree.h"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+using Sum = monoid::Sum<long long>;
+using Min = monoid::Min<long long>;
+using Max = monoid::Max<long long>;
+using Gcd = monoid::Gcd<long long>;
+
+// Runs random operations on a tree and a plain vector side by side. update(lo, hi)
+// applies a random update to both; check(lo, hi) compares one query.
+template <typename Update, typename Check>
+void randomOperations(const int n, std::mt19937& rng, Update update, Check check) {
+    std::uniform_int_distribution<int> index(0, n - 1);
+    for (int step = 0; step < 3000; ++step) {
+        int lo = index(rng), hi = index(rng);
+        if (lo > hi) std::swap(lo, hi);
+        if (rng() % 3 == 0) {
+            update(lo, hi);
+        } else {
+            check(lo, hi);
+        }
+    }
+}
+
+std::vector<long long> randomValues(const int n, std::mt19937& rng) {
+    std::vector<long long> values(n);
+    for (auto& v : values) v = static_cast<long long>(rng() % 2001) - 1000;
+    return values;
+}
+
+void testSumMinAddMatchesSegmentTree() {
+    std::mt19937 rng(1);
+    for (const int n : {1, 7, 16, 100, 1000}) {
+        std::vector<long long> values = randomValues(n, rng);
+        SumMinAddSegmentTree<long long> tree(values);
+        SegmentTree<long long> reference(values);
+        randomOperations(n, rng, [&](int lo, int hi) {
+            const long long delta = static_cast<long long>(rng() % 201) - 100;
+            tree.apply(lo, hi, {delta});
+            reference.rangeUpdate(lo, hi, delta);
+        }, [&](int lo, int hi) {
+            assert(tree.query<Sum>(lo, hi) == reference.rangeSum(lo, hi));
+            assert(tree.query<Min>(lo, hi) == reference.rangeMin(lo, hi));
+        });
+    }
+}
+
+void testAssignAddWithSumMinMax() {
+    std::mt19937 rng(2);
+    for (const int n : {1, 5, 64, 300}) {
+        std::vector<long long> naive = randomValues(n, rng);
+        MonoidSegmentTree<long long, tag::AssignAdd<long long>, Sum, Min, Max> tree(naive);
+        randomOperations(n, rng, [&](int lo, int hi) {
+            const long long value = static_cast<long long>(rng() % 201) - 100;
+            if (rng() % 2) {
+                tree.apply(lo, hi, tag::AssignAdd<long long>::assignTo(value));
+                std::fill(naive.begin() + lo, naive.begin() + hi + 1, value);
+            } else {
+                tree.apply(lo, hi, tag::AssignAdd<long long>::add(value));
+                for (int i = lo; i <= hi; ++i) naive[i] += value;
+            }
+        }, [&](int lo, int hi) {
+            assert(tree.query<Sum>(lo, hi) == std::accumulate(naive.begin() + lo, naive.begin() + hi + 1, 0LL));
+            assert(tree.query<Min>(lo, hi) == *std::min_element(naive.begin() + lo, naive.begin() + hi + 1));
+            assert(tree.query<Max>(lo, hi) == *std::max_element(naive.begin() + lo, naive.begin() + hi + 1));
+        });
+    }
+}
+
+void testGcdWithAssignAndSet() {
+    std::mt19937 rng(3);
+    const int n = 200;
+    std::vector<long long> naive(n);
+    for (auto& v : naive) v = 6 * static_cast<long long>(rng() % 50 + 1);
+    MonoidSegmentTree<long long, tag::Assign<long long>, Gcd> tree(naive);
+    randomOperations(n, rng, [&](int lo, int hi) {
+        const long long value = 4 * static_cast<long long>(rng() % 30 + 1);
+        if (rng() % 2) {
+            tree.apply(lo, hi, {value});
+            std::fill(naive.begin() + lo, naive.begin() + hi + 1, value);
+        } else {
+            tree.set(lo, -value);
+            naive[lo] = -value;
+        }
+    }, [&](int lo, int hi) {
+        long long expected = 0;
+        for (int i = lo; i <= hi; ++i) expected = std::gcd(expected, naive[i]);
+        assert(tree.query<Gcd>(lo, hi) == expected);
+    });
+}
+
+void testAffineSum() {
+    std::mt19937 rng(4);
+    const int n = 150;
+    std::vector<long long> naive = randomValues(n, rng);
+    MonoidSegmentTree<long long, tag::Affine<long long>, Sum> tree(naive);
+    randomOperations(n, rng, [&](int lo, int hi) {
+        // Slopes of magnitude at most 1 keep the values from overflowing.
+        const tag::Affine<long long> f{static_cast<long long>(rng() % 3) - 1, static_cast<long long>(rng() % 21) - 10};
+        tree.apply(lo, hi, f);
+        for (int i = lo; i <= hi; ++i) naive[i] = f.scale * naive[i] + f.offset;
+    }, [&](int lo, int hi) {
+        assert(tree.query<Sum>(lo, hi) == std::accumulate(naive.begin() + lo, naive.begin() + hi + 1, 0LL));
+    });
+}
+
+// A custom monoid that is not commutative: the first non-zero element of a range.
+struct FirstNonZero {
+    using value_type = std::optional<long long>;
+    static constexpr bool idempotent = true;
+    static value_type identity() { return std::nullopt; }
+    static value_type combine(const value_type& left, const value_type& right) { return left ? left : right; }
+    static value_type of(const long long& x) { return x != 0 ? value_type(x) : std::nullopt; }
+};
+
+// A custom monoid that is not idempotent, so tag::Assign needs an Action for it.
+struct CountPositive {
+    using value_type = size_t;
+    static size_t identity() { return 0; }
+    static size_t combine(const size_t left, const size_t right) { return left + right; }
+    static size_t of(const long long& x) { return x > 0 ? 1 : 0; }
+};
+
+template <>
+struct tag::Action<tag::Assign<long long>, CountPositive> {
+    static size_t apply(const tag::Assign<long long>& t, const size_t count, const size_t length) {
+        return t.value ? (*t.value > 0 ? length : 0) : count;
+    }
+};
+
+void testCustomMonoids() {
+    std::mt19937 rng(5);
+    const int n = 120;
+    std::vector<long long> naive(n);
+    for (auto& v : naive) v = static_cast<long long>(rng() % 5) - 2;
+    MonoidSegmentTree<long long, tag::Assign<long long>, FirstNonZero, CountPositive> tree(naive);
+    randomOperations(n, rng, [&](int lo, int hi) {
+        const long long value = static_cast<long long>(rng() % 5) - 2;
+        tree.apply(lo, hi, {value});
+        std::fill(naive.begin() + lo, naive.begin() + hi + 1, value);
+    }, [&](int lo, int hi) {
+        const auto first = std::find_if(naive.begin() + lo, naive.begin() + hi + 1, [](long long x) { return x != 0; });
+        if (first == naive.begin() + hi + 1) {
+            assert(!tree.query<FirstNonZero>(lo, hi));
+        } else {
+            assert(tree.query<FirstNonZero>(lo, hi) == *first);
+        }
+        assert(tree.query<CountPositive>(lo, hi) ==
+               static_cast<size_t>(std::count_if(naive.begin() + lo, naive.begin() + hi + 1, [](long long x) {
+                   return x > 0;
+               })));
+    });
+
+    // Without a tag the tree only supports set.
+    std::vector<long long> values = {3, 1, 4, 1, 5};
+    MonoidSegmentTree<long long, tag::None, Max> maxima(values);
+    assert(maxima.query<Max>(0, 4) == 5);
+    maxima.set(4, 0);
+    assert(maxima.query<Max>(0, 4) == 4);
+    assert(maxima.query<Max>(2, 2) == 4);
+}
+
+volatile long long benchmarkSink = 0;
+
+struct Operation {
+    int lo, hi;
+    bool update;
+};
+
+// The sum-only workload the old Node paid for three aggregates on: range adds and range sums.
+template <typename Update, typename Query>
+double millionOpsPerSecond(const std::vector<Operation>& operations, Update update, Query query) {
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const Operation& op : operations) {
+        if (op.update) {
+            update(op.lo, op.hi);
+        } else {
+            sink += query(op.lo, op.hi);
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink = benchmarkSink + sink;
+    return operations.size() / elapsed.count() / 1e6;
+}
+
+void benchmarkSumOnly() {
+    constexpr int n = 10000000;
+    constexpr int count = 2000000;
+    std::mt19937 rng(42);
+    std::vector<long long> values(n);
+    for (auto& v : values) v = static_cast<long long>(rng() % 1000000);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    std::vector<Operation> operations(count);
+    for (auto& op : operations) {
+        op.lo = index(rng);
+        op.hi = index(rng);
+        if (op.lo > op.hi) std::swap(op.lo, op.hi);
+        op.update = rng() % 4 == 0;
+    }
+
+    std::cout << "\nMillion operations per second, n = " << n << ", 25% range add / 75% range sum" << std::endl;
+    std::cout << "tree\t\t\t\t\tMops/s\tbytes/element" << std::endl;
+    {
+        RecursiveSegmentTree<long long> tree(values);
+        std::cout << "RecursiveSegmentTree (sum, min, max)\t"
+                  << millionOpsPerSecond(operations, [&](int lo, int hi) { tree.rangeUpdate(lo, hi, 1); },
+                                         [&](int lo, int hi) { return tree.rangeSum(lo, hi); })
+                  << "\t" << (2 * 3 + 2) * 8 * std::bit_ceil(static_cast<unsigned>(n)) / n << std::endl;
+    }
+    {
+        MonoidSegmentTree<long long, tag::Add<long long>, Sum, Min, Max> tree(values);
+        std::cout << "MonoidSegmentTree<Add, Sum, Min, Max>\t"
+                  << millionOpsPerSecond(operations, [&](int lo, int hi) { tree.apply(lo, hi, {1}); },
+                                         [&](int lo, int hi) { return tree.query<Sum>(lo, hi); })
+                  << "\t" << (2 * 3 + 1) * 8 * std::bit_ceil(static_cast<unsigned>(n)) / n << std::endl;
+    }
+    {
+        MonoidSegmentTree<long long, tag::Add<long long>, Sum> tree(values);
+        std::cout << "MonoidSegmentTree<Add, Sum>\t\t"
+                  << millionOpsPerSecond(operations, [&](int lo, int hi) { tree.apply(lo, hi, {1}); },
+                                         [&](int lo, int hi) { return tree.query<Sum>(lo, hi); })
+                  << "\t" << (2 * 1 + 1) * 8 * std::bit_ceil(static_cast<unsigned>(n)) / n << std::endl;
+    }
+    {
+        SegmentTree<long long> tree(values);
+        std::cout << "SegmentTree (blocked, sum and min)\t"
+                  << millionOpsPerSecond(operations, [&](int lo, int hi) { tree.rangeUpdate(lo, hi, 1); },
+                                         [&](int lo, int hi) { return tree.rangeSum(lo, hi); })
+                  << std::endl;
+    }
+}
+
+int main() {
+    test("Sum Min Add Matches SegmentTree", testSumMinAddMatchesSegmentTree);
+    test("Assign Add With Sum Min Max", testAssignAddWithSumMinMax);
+    test("Gcd With Assign And Set", testGcdWithAssignAndSet);
+    test("Affine Sum", testAffineSum);
+    test("Custom Monoids", testCustomMonoids);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkSumOnly();
+    return 0;
+}
@@ -0,0 +1,370 @@
+#ifndef CPP_DATASTRUCTURES_MONOIDSEGMENTTREE_H
+#define CPP_DATASTRUCTURES_MONOIDSEGMENTTREE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Aggregates a MonoidSegmentTree can maintain. A monoid M over elements of type T provides
+ *   using value_type;
+ *   static value_type identity();
+ *   static value_type combine(const value_type& left, const value_type& right);
+ *   static value_type of(const T& element);
+ * where combine is associative with identity as its neutral element. It need not be
+ * commutative: left always covers the elements before right. A monoid whose combine(v, v) is
+ * v declares static constexpr bool idempotent = true, which is all tag::Assign needs to know.
+ */
+namespace monoid {
+
+template <typename T>
+struct Sum {
+    using value_type = T;
+    static T identity() { return T(0); }
+    static T combine(const T& left, const T& right) { return left + right; }
+    static T of(const T& element) { return element; }
+};
+
+template <typename T>
+struct Min {
+    using value_type = T;
+    static constexpr bool idempotent = true;
+    static T identity() { return std::numeric_limits<T>::max(); }
+    static T combine(const T& left, const T& right) { return std::min(left, right); }
+    static T of(const T& element) { return element; }
+};
+
+template <typename T>
+struct Max {
+    using value_type = T;
+    static constexpr bool idempotent = true;
+    static T identity() { return std::numeric_limits<T>::lowest(); }
+    static T combine(const T& left, const T& right) { return std::max(left, right); }
+    static T of(const T& element) { return element; }
+};
+
+template <typename T>
+struct Gcd {
+    using value_type = T;
+    static constexpr bool idempotent = true;
+    static T identity() { return T(0); }
+    static T combine(const T& left, const T& right) { return std::gcd(left, right); }
+    static T of(const T& element) { return element < 0 ? -element : element; }
+};
+
+} // namespace monoid
+
+/**
+ * Range updates a MonoidSegmentTree can apply. A tag is a function on elements; it provides
+ *   static Tag compose(const Tag& outer, const Tag& inner);   // inner first, then outer
+ * and its default-constructed value is the identity, compared with ==. How a tag changes each
+ * aggregate is given by Action<Tag, Monoid>::apply(tag, value, length), where length is the
+ * number of elements value covers. Specialize Action to use a tag with a custom monoid; a tree
+ * whose tag has no Action for one of its monoids does not compile.
+ */
+namespace tag {
+
+/**
+ * @brief No range updates; the tree only supports set.
+ */
+struct None {
+    static None compose(const None&, const None&) { return {}; }
+    bool operator==(const None&) const = default;
+};
+
+/**
+ * @brief x -> x + delta.
+ */
+template <typename T>
+struct Add {
+    T delta = T(0);
+    static Add compose(const Add& outer, const Add& inner) { return {outer.delta + inner.delta}; }
+    bool operator==(const Add&) const = default;
+};
+
+/**
+ * @brief x -> value, or no change when empty.
+ */
+template <typename T>
+struct Assign {
+    std::optional<T> value;
+    static Assign compose(const Assign& outer, const Assign& inner) { return outer.value ? outer : inner; }
+    bool operator==(const Assign&) const = default;
+};
+
+/**
+ * @brief The affine maps with slope 0 or 1: x -> value when assign is set, else x -> x + value.
+ * Range assignment and range addition mixed in one tree.
+ */
+template <typename T>
+struct AssignAdd {
+    bool assign = false;
+    T value = T(0);
+
+    static AssignAdd assignTo(const T& value) { return {true, value}; }
+    static AssignAdd add(const T& delta) { return {false, delta}; }
+    static AssignAdd compose(const AssignAdd& outer, const AssignAdd& inner) {
+        return outer.assign ? outer : AssignAdd{inner.assign, inner.value + outer.value};
+    }
+    bool operator==(const AssignAdd&) const = default;
+};
+
+/**
+ * @brief x -> scale * x + offset.
+ */
+template <typename T>
+struct Affine {
+    T scale = T(1);
+    T offset = T(0);
+    static Affine compose(const Affine& outer, const Affine& inner) {
+        return {outer.scale * inner.scale, outer.scale * inner.offset + outer.offset};
+    }
+    bool operator==(const Affine&) const = default;
+};
+
+template <typename Tag, typename Monoid>
+struct Action;
+
+template <typename Monoid>
+struct Action<None, Monoid> {
+    static typename Monoid::value_type apply(const None&, const typename Monoid::value_type& value, size_t) {
+        return value;
+    }
+};
+
+template <typename T>
+struct Action<Add<T>, monoid::Sum<T>> {
+    static T apply(const Add<T>& tag, const T& sum, const size_t length) { return sum + tag.delta * static_cast<T>(length); }
+};
+
+template <typename T>
+struct Action<Add<T>, monoid::Min<T>> {
+    static T apply(const Add<T>& tag, const T& min, size_t) { return min + tag.delta; }
+};
+
+template <typename T>
+struct Action<Add<T>, monoid::Max<T>> {
+    static T apply(const Add<T>& tag, const T& max, size_t) { return max + tag.delta; }
+};
+
+template <typename T>
+struct Action<Assign<T>, monoid::Sum<T>> {
+    static T apply(const Assign<T>& tag, const T& sum, const size_t length) {
+        return tag.value ? *tag.value * static_cast<T>(length) : sum;
+    }
+};
+
+// length copies of one value aggregate to that value alone.
+template <typename T, typename Monoid>
+    requires(Monoid::idempotent)
+struct Action<Assign<T>, Monoid> {
+    static typename Monoid::value_type apply(const Assign<T>& tag, const typename Monoid::value_type& value, size_t) {
+        return tag.value ? Monoid::of(*tag.value) : value;
+    }
+};
+
+template <typename T, typename Monoid>
+struct Action<AssignAdd<T>, Monoid> {
+    static typename Monoid::value_type apply(const AssignAdd<T>& tag, const typename Monoid::value_type& value,
+                                             const size_t length) {
+        if (tag.assign) {
+            return Action<Assign<T>, Monoid>::apply(Assign<T>{tag.value}, value, length);
+        }
+        return Action<Add<T>, Monoid>::apply(Add<T>{tag.value}, value, length);
+    }
+};
+
+template <typename T>
+struct Action<Affine<T>, monoid::Sum<T>> {
+    static T apply(const Affine<T>& tag, const T& sum, const size_t length) {
+        return tag.scale * sum + tag.offset * static_cast<T>(length);
+    }
+};
+
+} // namespace tag
+
+/**
+ * @brief A segment tree over elements of type T that maintains exactly the aggregates it is
+ * given, with range updates of type Tag.
+ *
+ * Each monoid's values live in their own array (structure of arrays), so a query for one
+ * aggregate only reads that aggregate's array, and an update only merges the aggregates the
+ * tree was instantiated with:
+ *
+ * @code
+ *   MonoidSegmentTree<long long, tag::Add<long long>, monoid::Sum<long long>> sums(values);
+ *   sums.apply(2, 7, {5});
+ *   long long total = sums.query<monoid::Sum<long long>>(0, 9);
+ * @endcode
+ *
+ * The tree is iterative and power-of-two sized. An operation on [first, last] first pushes
+ * pending tags down the two boundary paths from the root, so every node it then reads or tags
+ * is up to date, and afterwards recomputes those two paths; no other node is touched. Pushing
+ * rather than keeping tags permanently in place is what lets tags that do not commute, such as
+ * assignment, work. With tag::None there are no tags to push.
+ *
+ * The min/sum/add SegmentTree is the instantiation SumMinAddSegmentTree below; SegmentTree
+ * keeps its own blocked layout, which is faster for that one case.
+ * @tparam T The element type.
+ * @tparam Tag The range update, one of the types in namespace tag or a user-defined one.
+ * @tparam Monoids The aggregates to maintain, from namespace monoid or user-defined.
+ */
+template <typename T, typename Tag, typename... Monoids>
+class MonoidSegmentTree {
+    static_assert(sizeof...(Monoids) > 0, "A MonoidSegmentTree needs at least one monoid.");
+
+private:
+    static constexpr bool hasTags = !std::is_same_v<Tag, tag::None>;
+
+    template <typename M, typename First, typename... Rest>
+    static constexpr size_t indexOf() {
+        if constexpr (std::is_same_v<M, First>) {
+            return 0;
+        } else {
+            static_assert(sizeof...(Rest) > 0, "The tree does not maintain this monoid.");
+            return 1 + indexOf<M, Rest...>();
+        }
+    }
+
+    std::tuple<std::vector<typename Monoids::value_type>...> _aggregates;
+    // Pending tags of the internal nodes.
+    std::vector<Tag> _tags;
+    int _size;
+    int _levels;
+
+    template <typename M>
+    std::vector<typename M::value_type>& aggregate() {
+        return std::get<indexOf<M, Monoids...>()>(_aggregates);
+    }
+
+    void pull(const int pos) {
+        ((aggregate<Monoids>()[pos] = Monoids::combine(aggregate<Monoids>()[2 * pos], aggregate<Monoids>()[2 * pos + 1])),
+         ...);
+    }
+
+    void applyTag(const int pos, const Tag& t, const size_t length) {
+        ((aggregate<Monoids>()[pos] = tag::Action<Tag, Monoids>::apply(t, aggregate<Monoids>()[pos], length)), ...);
+        if (pos < _size) {
+            _tags[pos] = Tag::compose(t, _tags[pos]);
+        }
+    }
+
+    /**
+     * @brief Hands a node's pending tag to its children.
+     * @param level Height of the node above the leaves.
+     */
+    void push(const int pos, const int level) {
+        if (_tags[pos] == Tag{}) {
+            return;
+        }
+        const size_t childLength = size_t{1} << (level - 1);
+        applyTag(2 * pos, _tags[pos], childLength);
+        applyTag(2 * pos + 1, _tags[pos], childLength);
+        _tags[pos] = Tag{};
+    }
+
+    /**
+     * @brief Pushes tags down to the boundary leaves l and r - 1 of a half-open leaf range,
+     * stopping above nodes that lie entirely inside it.
+     */
+    void pushBoundaries(const int l, const int r) {
+        if constexpr (hasTags) {
+            for (int level = _levels; level > 0; --level) {
+                if (((l >> level) << level) != l) push(l >> level, level);
+                if (((r >> level) << level) != r) push((r - 1) >> level, level);
+            }
+        }
+    }
+
+    void pullBoundaries(const int l, const int r) {
+        for (int level = 1; level <= _levels; ++level) {
+            if (((l >> level) << level) != l) pull(l >> level);
+            if (((r >> level) << level) != r) pull((r - 1) >> level);
+        }
+    }
+
+public:
+    /**
+     * @param values The initial elements.
+     * Time Complexity: O(N)
+     */
+    explicit MonoidSegmentTree(const std::vector<T>& values)
+        : _size(static_cast<int>(std::bit_ceil(std::max<size_t>(values.size(), 1)))),
+          _levels(std::countr_zero(static_cast<unsigned>(_size))) {
+        ((aggregate<Monoids>().assign(2 * _size, Monoids::identity())), ...);
+        if constexpr (hasTags) {
+            _tags.assign(_size, Tag{});
+        }
+        for (size_t i = 0; i < values.size(); ++i) {
+            ((aggregate<Monoids>()[_size + i] = Monoids::of(values[i])), ...);
+        }
+        for (int pos = _size - 1; pos > 0; --pos) {
+            pull(pos);
+        }
+    }
+
+    /**
+     * @brief Aggregate of one monoid over the elements [first, last].
+     * Time Complexity: O(log N)
+     */
+    template <typename M>
+    typename M::value_type query(int first, int last) {
+        int l = first + _size;
+        int r = last + 1 + _size;
+        pushBoundaries(l, r);
+        const auto& values = aggregate<M>();
+        typename M::value_type left = M::identity();
+        typename M::value_type right = M::identity();
+        for (; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) left = M::combine(left, values[l++]);
+            if (r & 1) right = M::combine(values[--r], right);
+        }
+        return M::combine(left, right);
+    }
+
+    /**
+     * @brief Applies a tag to every element in [first, last].
+     * Time Complexity: O(log N)
+     */
+    void apply(const int first, const int last, const Tag& t) requires(hasTags) {
+        const int l0 = first + _size;
+        const int r0 = last + 1 + _size;
+        pushBoundaries(l0, r0);
+        size_t length = 1;
+        for (int l = l0, r = r0; l < r; l >>= 1, r >>= 1, length <<= 1) {
+            if (l & 1) applyTag(l++, t, length);
+            if (r & 1) applyTag(--r, t, length);
+        }
+        pullBoundaries(l0, r0);
+    }
+
+    /**
+     * @brief Replaces the element at index.
+     * Time Complexity: O(log N)
+     */
+    void set(const int index, const T& value) {
+        int pos = index + _size;
+        pushBoundaries(pos, pos + 1);
+        ((aggregate<Monoids>()[pos] = Monoids::of(value)), ...);
+        for (pos >>= 1; pos > 0; pos >>= 1) {
+            pull(pos);
+        }
+    }
+};
+
+/**
+ * @brief SegmentTree's aggregates and updates as a MonoidSegmentTree: range add with range sum
+ * and range min. rangeSum(l, r) is query<monoid::Sum<T>>(l, r), rangeUpdate(l, r, d) is
+ * apply(l, r, {d}) and pointUpdate(i, d) is apply(i, i, {d}).
+ */
+template <typename T = long long>
+using SumMinAddSegmentTree = MonoidSegmentTree<T, tag::Add<T>, monoid::Sum<T>, monoid::Min<T>>;
+
+#endif //CPP_DATASTRUCTURES_MONOIDSEGMENTTREE_H
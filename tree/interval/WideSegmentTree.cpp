@@ -0,0 +1,198 @@
+#include "WideSegmentTree.h"
+#include "SegmentTree.h"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+void test(const std::string& name, std::function<void()> func) {
+    std::cout << "Running test: " << name << "..." << std::endl;
+    try {
+        func();
+        std::cout << "PASSED" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "FAILED" << std::endl;
+        std::cout << "  Reason: " << e.what() << std::endl;
+    }
+}
+
+void testSmallExample() {
+    std::vector<long long> values = {5, -2, 7, 1, 3};
+    WideSegmentTree<long long> tree(values);
+    assert(tree.size() == 5);
+    assert(tree.rangeSum(0, 4) == 14);
+    assert(tree.rangeSum(1, 2) == 5);
+    assert(tree.prefixSum(0) == 0);
+    tree.pointUpdate(4, -10);
+    assert(tree.rangeSum(4, 4) == -7);
+    assert(tree.prefixSum(5) == 4);
+}
+
+// Random point updates and range sums against a plain vector, for sizes around powers of
+// the branching factors, where a level gains a node or the tree gains a level.
+template <typename T, int Branching>
+void matchesNaive() {
+    std::mt19937 rng(7);
+    for (const int n : {1, 2, 7, 8, 9, 15, 16, 17, 63, 64, 65, 255, 256, 257, 511, 512, 513, 4096, 5000}) {
+        std::vector<T> naive(n);
+        for (auto& v : naive) v = static_cast<T>(rng() % 2001) - 1000;
+        WideSegmentTree<T, Branching> tree(naive);
+        std::uniform_int_distribution<int> index(0, n - 1);
+        for (int step = 0; step < 4000; ++step) {
+            int lo = index(rng), hi = index(rng);
+            if (lo > hi) std::swap(lo, hi);
+            if (rng() % 3 == 0) {
+                const T delta = static_cast<T>(rng() % 201) - 100;
+                tree.pointUpdate(lo, delta);
+                naive[lo] += delta;
+            } else {
+                assert(tree.rangeSum(lo, hi) == std::accumulate(naive.begin() + lo, naive.begin() + hi + 1, T(0)));
+            }
+        }
+        assert(tree.prefixSum(n) == std::accumulate(naive.begin(), naive.end(), T(0)));
+    }
+}
+
+void testMatchesNaiveWithLongLong() {
+    matchesNaive<long long, 8>();
+    matchesNaive<long long, 16>();
+    matchesNaive<long long, 32>();
+}
+
+void testMatchesNaiveWithInt() {
+    matchesNaive<int, 16>();
+    matchesNaive<unsigned, 32>();
+}
+
+template <typename T>
+void floatingPoint() {
+    // Small integers and halves stay exact, so the sums can be compared exactly.
+    std::vector<T> values(1000);
+    std::iota(values.begin(), values.end(), T(0));
+    WideSegmentTree<T> tree(values);
+    assert(tree.rangeSum(10, 19) == T(145));
+    tree.pointUpdate(15, T(0.5));
+    assert(tree.rangeSum(10, 19) == T(145.5));
+    assert(tree.rangeSum(16, 19) == T(70));
+    assert(tree.rangeSum(0, 999) == T(499500.5));
+}
+
+void testFloatingPoint() {
+    floatingPoint<double>();
+    floatingPoint<float>();
+}
+
+void testAssignRebuilds() {
+    std::vector<int> values(100, 1);
+    WideSegmentTree<int> tree(values);
+    tree.pointUpdate(3, 5);
+    assert(tree.rangeSum(0, 99) == 105);
+    values.assign(300, 2);
+    tree.assign(values);
+    assert(tree.size() == 300);
+    assert(tree.rangeSum(0, 299) == 600);
+    assert(tree.rangeSum(3, 3) == 2);
+    tree.assign({});
+    assert(tree.size() == 0);
+    assert(tree.prefixSum(0) == 0);
+}
+
+void testMatchesSegmentTree() {
+    std::mt19937 rng(11);
+    constexpr int n = 100000;
+    std::vector<long long> values(n);
+    for (auto& v : values) v = static_cast<long long>(rng() % 1000000);
+    WideSegmentTree<long long> tree(values);
+    SegmentTree<long long> reference(values);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    for (int step = 0; step < 20000; ++step) {
+        int lo = index(rng), hi = index(rng);
+        if (lo > hi) std::swap(lo, hi);
+        if (step % 4 == 0) {
+            const long long delta = static_cast<long long>(rng() % 2001) - 1000;
+            tree.pointUpdate(lo, delta);
+            reference.pointUpdate(lo, delta);
+        }
+        assert(tree.rangeSum(lo, hi) == reference.rangeSum(lo, hi));
+    }
+}
+
+void testQueriesAreConst() {
+    std::vector<int> values = {4, 2, 9};
+    const WideSegmentTree<int> tree(values);
+    assert(tree.rangeSum(0, 2) == 15);
+    assert(tree.rangeSum(1, 2) == 11);
+}
+
+volatile long long benchmarkSink = 0;
+
+template <typename Op>
+double millionOpsPerSecond(const std::vector<std::pair<int, int>>& ranges, Op op) {
+    long long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& [lo, hi] : ranges) {
+        sink += op(lo, hi);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    benchmarkSink = benchmarkSink + sink;
+    return ranges.size() / elapsed.count() / 1e6;
+}
+
+template <typename Tree>
+std::vector<double> runOperations(const std::vector<long long>& values, const std::vector<std::pair<int, int>>& ranges) {
+    Tree tree(values);
+    return {
+        millionOpsPerSecond(ranges, [&](int lo, int hi) { return tree.rangeSum(lo, hi); }),
+        millionOpsPerSecond(ranges, [&](int lo, int) {
+            tree.pointUpdate(lo, 1);
+            return 0LL;
+        }),
+    };
+}
+
+// Sized well past the last-level cache, where the number of cache lines a query touches
+// decides its cost. The trees are built one at a time to bound peak memory.
+void benchmarkAgainstSegmentTree() {
+    constexpr int n = 1 << 26;
+    constexpr int operations = 4000000;
+    std::mt19937 rng(42);
+    std::vector<long long> values(n);
+    for (auto& v : values) v = static_cast<long long>(rng() % 1000000);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    std::vector<std::pair<int, int>> ranges(operations);
+    for (auto& [lo, hi] : ranges) {
+        lo = index(rng);
+        hi = index(rng);
+        if (lo > hi) std::swap(lo, hi);
+    }
+
+    const std::vector<double> binary = runOperations<SegmentTree<long long>>(values, ranges);
+    const std::vector<double> wide = runOperations<WideSegmentTree<long long>>(values, ranges);
+    const char* names[] = {"rangeSum", "pointUpdate"};
+    std::cout << "\nMillion operations per second, n = " << n << ", random ranges" << std::endl;
+    std::cout << "operation\tSegmentTree\tWideSegmentTree\tspeedup" << std::endl;
+    for (size_t i = 0; i < binary.size(); ++i) {
+        std::cout << names[i] << "\t" << binary[i] << "\t\t" << wide[i] << "\t\t" << wide[i] / binary[i] << "x"
+                  << std::endl;
+    }
+}
+
+int main() {
+    test("Small Example", testSmallExample);
+    test("Matches Naive With Long Long", testMatchesNaiveWithLongLong);
+    test("Matches Naive With Int", testMatchesNaiveWithInt);
+    test("Floating Point", testFloatingPoint);
+    test("Assign Rebuilds", testAssignRebuilds);
+    test("Matches SegmentTree", testMatchesSegmentTree);
+    test("Queries Are Const", testQueriesAreConst);
+    std::cout << "\nAll tests passed!" << std::endl;
+
+    benchmarkAgainstSegmentTree();
+    return 0;
+}